@@ -47,6 +47,12 @@
 extern uint8_t *a5200_screen_buffer;
 
 int break_ypos = 999;
+/* when set, the current frame will not be displayed: only lines
+   that can produce playfield collisions are drawn */
+int antic_skip_render = FALSE;
+/* when set, ANTIC_line_stats is filled in for each frame */
+int antic_collect_line_stats = FALSE;
+void (*antic_trace_hook)(int ypos) = NULL;
 #ifdef NEW_CYCLE_EXACT
 void draw_partial_scanline(int l,int r);
 void update_scanline(void);
@@ -307,7 +313,9 @@ unsigned int screenline_cpu_clock = 0;
 	screenline_cpu_clock += LINE_C; \
 	ypos++; \
 	update_pmpl_colls();
-#define GOEOL GO(LINE_C); xpos -= LINE_C; screenline_cpu_clock += LINE_C; UPDATE_DMACTL ypos++
+#define GOEOL GO(LINE_C); LINE_STATS_EOL xpos -= LINE_C; screenline_cpu_clock += LINE_C; UPDATE_DMACTL ypos++; TRACE_EOL
+#define TRACE_EOL if (antic_trace_hook && (ypos & (ANTIC_TRACE_BAND_LINES - 1)) == 0 && ypos < max_ypos) antic_trace_hook(ypos);
+#define LINE_STATS_EOL if (antic_collect_line_stats) end_line_stats();
 #define OVERSCREEN_LINE	xpos += DMAR; GOEOL
 
 int xpos = 0;
@@ -316,6 +324,56 @@ UBYTE wsync_halt = FALSE;
 
 int ypos;						/* Line number - lines 8..247 are on screen */
 
+/* Per-scanline cycle accounting ------------------------------------------- */
+
+ANTIC_line_stat ANTIC_line_stats[ANTIC_LINE_STATS_MAX];
+int antic_line_cpu_cycles = 0;
+int antic_line_wsync_cycles = 0;
+static int line_start_xpos = 0;	/* xpos carried over into the current line */
+static UBYTE line_nmi = 0;
+
+const ANTIC_line_stat *ANTIC_GetLineStats(int *lines)
+{
+	*lines = max_ypos < ANTIC_LINE_STATS_MAX ? max_ypos : ANTIC_LINE_STATS_MAX;
+	return ANTIC_line_stats;
+}
+
+static UBYTE line_stat_clamp(int cycles)
+{
+	if (cycles < 0)
+		return 0;
+	return (UBYTE) (cycles > 255 ? 255 : cycles);
+}
+
+/* Called at the end of each line, before xpos is moved to the next one.
+   Whatever xpos advanced by outside GO() and NMI() was stolen by ANTIC. */
+static void end_line_stats(void)
+{
+	if (ypos >= 0 && ypos < ANTIC_LINE_STATS_MAX) {
+		ANTIC_line_stat *stat = &ANTIC_line_stats[ypos];
+		stat->dma_cycles = line_stat_clamp(xpos - line_start_xpos
+			- antic_line_cpu_cycles - antic_line_wsync_cycles);
+		stat->cpu_cycles = line_stat_clamp(antic_line_cpu_cycles);
+		stat->wsync_cycles = line_stat_clamp(antic_line_wsync_cycles);
+		stat->nmi = line_nmi;
+	}
+	line_start_xpos = xpos - LINE_C;
+	antic_line_cpu_cycles = 0;
+	antic_line_wsync_cycles = 0;
+	line_nmi = 0;
+}
+
+/* NMI(), recording the interrupt in the line statistics */
+static void antic_nmi(UBYTE line_flag)
+{
+	int nmi_xpos = xpos;
+	NMI();
+	if (antic_collect_line_stats) {
+		antic_line_cpu_cycles += xpos - nmi_xpos;
+		line_nmi |= line_flag;
+	}
+}
+
 /* Timing in first line of modes 2-5
 In these modes ANTIC takes more bytes than cycles. Despite this, it would be
 possible that SCR_C + cycles_taken > WSYNC_C. To avoid this we must take some
@@ -365,15 +423,20 @@ static int extra_cycles[6];
 /* border parameters for current display width */
 static int left_border_chars;
 static int right_border_start;
-#ifdef NEW_CYCLE_EXACT
+static int playfield_start = 16;	/* first playfield colour clock */
+/* drawn border range, narrowed by ANTIC_SetRenderWindow */
 static int left_border_start = LCHOP * 4;
 static int right_border_end = (48 - RCHOP) * 4;
 #define LBORDER_START left_border_start
 #define RBORDER_END right_border_end
-#else
-#define LBORDER_START (LCHOP * 4)
-#define RBORDER_END ((48 - RCHOP) * 4)
-#endif /* NEW_CYCLE_EXACT */
+#define UPDATE_LEFT_BORDER_CHARS left_border_chars = playfield_start > LBORDER_START ? (playfield_start - LBORDER_START) >> 2 : 0;
+
+/* render window: colour clocks render_left..render_right-1 of lines
+   render_top..render_bottom-1, counted from the first displayed line */
+static int render_left = LCHOP * 4;
+static int render_right = (48 - RCHOP) * 4;
+static int render_top = 0;
+static int render_bottom = ATARI_HEIGHT;
 
 /* set with CHBASE *and* CHACTL - bits 0..2 set if flip on */
 static UWORD chbase_20;			/* CHBASE for 20 character mode */
@@ -765,9 +828,33 @@ static void setup_art_colours(void)
 	}
 }
 
+/* Redundant writes -------------------------------------------------------- */
+
+/* Registers whose writes only update state derived from the value written,
+   so that rewriting the current value has no effect: CHACTL, HSCROL,
+   PMBASE, CHBASE and DMACTL. DLISTL/DLISTH are excluded, as the display
+   list pointer is advanced by ANTIC itself. */
+#ifdef NEW_CYCLE_EXACT
+/* DMACTL writes also cancel delayed DMACTL changes */
+#define ELIDABLE_REGS 0x0292U
+#else
+#define ELIDABLE_REGS 0x0293U
+#endif
+
+/* Last value written to each of the above registers */
+static UWORD write_shadow[16];
+
+static void reset_write_shadow(void)
+{
+	int i;
+	for (i = 0; i < 16; i++)
+		write_shadow[i] = WRITE_SHADOW_INVALID;
+}
+
 /* Initialization ---------------------------------------------------------- */
 
 void ANTIC_Initialise(void) {
+	reset_write_shadow();
 	ANTIC_UpdateArtifacting();
 
 	playfield_lookup[0x00] = L_BAK;
@@ -799,6 +886,21 @@ void ANTIC_Reset(void) {
 	ANTIC_PutByte(_DMACTL, 0);
 }
 
+void ANTIC_SetRenderWindow(int x, int y, int width, int height)
+{
+	render_left = x >> 1;
+	if (render_left < LCHOP * 4)
+		render_left = LCHOP * 4;
+	render_right = (x + width) >> 1;
+	if (render_right > (48 - RCHOP) * 4)
+		render_right = (48 - RCHOP) * 4;
+	render_top = y;
+	render_bottom = y + height;
+	left_border_start = render_left;
+	right_border_end = render_right;
+	UPDATE_LEFT_BORDER_CHARS
+}
+
 /* Border ------------------------------------------------------------------ */
 
 #define DO_BORDER_1 {\
@@ -1069,6 +1171,32 @@ static void draw_an_gtia11(const ULONG *t_pm_scanline_ptr)
 #define DO_PMG_LORES PF_COLLS(colreg) |= pm_pixel = *c_pm_scanline_ptr++;\
 	WRITE_VIDEO(ptr++, COLOUR(pm_lookup_ptr[pm_pixel] | colreg));
 
+/* PMG over four pixels of the same playfield colour
+   The whole group is handled with one long read of the PMG scanline:
+   collisions are registered once and PMG data repeated over the group
+   (the inside of a player) needs a single colour lookup. */
+#define PM_GROUP_IS_UNIFORM(pm) ((pm) == ((pm) & 0xff) * 0x01010101)
+#define PM_GROUP_COLLS(pm) ((UBYTE) ((pm) | ((pm) >> 8) | ((pm) >> 16) | ((pm) >> 24)))
+
+#define DO_PMG_LORES_GROUP(colreg) {\
+	ULONG pm_group = UNALIGNED_GET_LONG(t_pm_scanline_ptr, pm_scanline_read_long_stat);\
+	PF_COLLS(colreg) |= PM_GROUP_COLLS(pm_group);\
+	if (PM_GROUP_IS_UNIFORM(pm_group)) {\
+		UWORD pm_colour = COLOUR(pm_lookup_ptr[pm_group & 0xff] | colreg);\
+		WRITE_VIDEO(ptr++, pm_colour);\
+		WRITE_VIDEO(ptr++, pm_colour);\
+		WRITE_VIDEO(ptr++, pm_colour);\
+		WRITE_VIDEO(ptr++, pm_colour);\
+	}\
+	else {\
+		const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;\
+		WRITE_VIDEO(ptr++, COLOUR(pm_lookup_ptr[c_pm_scanline_ptr[0]] | colreg));\
+		WRITE_VIDEO(ptr++, COLOUR(pm_lookup_ptr[c_pm_scanline_ptr[1]] | colreg));\
+		WRITE_VIDEO(ptr++, COLOUR(pm_lookup_ptr[c_pm_scanline_ptr[2]] | colreg));\
+		WRITE_VIDEO(ptr++, COLOUR(pm_lookup_ptr[c_pm_scanline_ptr[3]] | colreg));\
+	}\
+}
+
 #ifdef ALTERNATE_LOOP_COUNTERS 	/* speeds-up pmg in hires a bit or not? try it :) */
 #define FOUR_LOOP_BEGIN(data) data |= 0x800000; do {	/* data becomes negative after four data <<= 2 */
 #define FOUR_LOOP_END(data) } while (data >= 0);
@@ -1085,13 +1213,25 @@ static void draw_an_gtia11(const ULONG *t_pm_scanline_ptr)
 #define DO_PMG_HIRES(data) {\
 	const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;\
 	int pm_pixel;\
-	FOUR_LOOP_BEGIN(data)\
-		pm_pixel = *c_pm_scanline_ptr++;\
-		if (data & 0xc0)\
-			PF2PM |= pm_pixel;\
-		WRITE_VIDEO(ptr++, (COLOUR(pm_lookup_ptr[pm_pixel] | L_PF2) & hires_mask(data & 0xc0)) | hires_lum(data & 0xc0));\
-		data <<= 2;\
-	FOUR_LOOP_END(data)\
+	ULONG pm_group = UNALIGNED_GET_LONG(t_pm_scanline_ptr, pm_scanline_read_long_stat);\
+	if (PM_GROUP_IS_UNIFORM(pm_group)) {\
+		UWORD pm_colour = COLOUR(pm_lookup_ptr[pm_group & 0xff] | L_PF2);\
+		if (data & 0xff)\
+			PF2PM |= (UBYTE) pm_group;\
+		WRITE_VIDEO(ptr++, (pm_colour & hires_mask(data & 0xc0)) | hires_lum(data & 0xc0));\
+		WRITE_VIDEO(ptr++, (pm_colour & hires_mask((data << 2) & 0xc0)) | hires_lum((data << 2) & 0xc0));\
+		WRITE_VIDEO(ptr++, (pm_colour & hires_mask((data << 4) & 0xc0)) | hires_lum((data << 4) & 0xc0));\
+		WRITE_VIDEO(ptr++, (pm_colour & hires_mask((data << 6) & 0xc0)) | hires_lum((data << 6) & 0xc0));\
+	}\
+	else {\
+		FOUR_LOOP_BEGIN(data)\
+			pm_pixel = *c_pm_scanline_ptr++;\
+			if (data & 0xc0)\
+				PF2PM |= pm_pixel;\
+			WRITE_VIDEO(ptr++, (COLOUR(pm_lookup_ptr[pm_pixel] | L_PF2) & hires_mask(data & 0xc0)) | hires_lum(data & 0xc0));\
+			data <<= 2;\
+		FOUR_LOOP_END(data)\
+	}\
 }
 
 
@@ -1111,27 +1251,86 @@ static void draw_an_gtia11(const ULONG *t_pm_scanline_ptr)
 	if (blank_lookup[screendata & blank_mask])\
 		chdata ^= chptr[(screendata & 0x7f) << 3];
 
+/* Expanded glyph rows
+   Character modes draw a font byte as a few screen words, always with the
+   same colours for a given pattern. The tables below hold pairs of screen
+   words (one long) for every font bit pattern that makes them, so a glyph
+   row is drawn with a couple of long copies. They're rebuilt only when
+   one of the colours they were expanded with changes, and since they're
+   indexed by the font data itself, writes to a font in RAM don't affect
+   them. */
+
+/* ANTIC 2 and 3: font nibble -> two hi-res words */
+static ULONG glyph_pairs_2[16];
+static ULONG glyph_key_2 = 0xffffffff;
+
+/* ANTIC 4 and 5: inverse video, font nibble -> two words;
+   ANTIC 6 and 7: character colour, two font bits -> two words */
+static ULONG glyph_pairs_4[2][16];
+static ULONG glyph_pairs_6[4][4];
+static UWORD glyph_key_mc[5] = { 0xffff, 0xffff, 0xffff, 0xffff, 0xffff };
+
+static void glyph_pair(ULONG *pair, UWORD first, UWORD second)
+{
+	((UWORD *) pair)[0] = first;
+	((UWORD *) pair)[1] = second;
+}
+
+/* call after INIT_HIRES */
+static void glyph_check_2(void)
+{
+	/* INIT_HIRES derives all hi-res colours from these two words */
+	ULONG key = ((ULONG) cl_lookup[C_PF2] << 16) | hires_lum(0xc0);
+	if (key != glyph_key_2) {
+		int i;
+		glyph_key_2 = key;
+		for (i = 0; i < 16; i++)
+			glyph_pair(&glyph_pairs_2[i], hires_norm((i & 0x0c) << 4), hires_norm((i & 0x03) << 6));
+	}
+}
+
+static void glyph_check_mc(void)
+{
+	if (glyph_key_mc[0] != cl_lookup[C_BAK] || glyph_key_mc[1] != cl_lookup[C_PF0]
+	 || glyph_key_mc[2] != cl_lookup[C_PF1] || glyph_key_mc[3] != cl_lookup[C_PF2]
+	 || glyph_key_mc[4] != cl_lookup[C_PF3]) {
+		int i;
+		int j;
+		for (i = 0; i < 5; i++)
+			glyph_key_mc[i] = i == 0 ? cl_lookup[C_BAK] : cl_lookup[C_PF0 + ((i - 1) << 4)];
+		/* 4/5: 00 = BAK, 01 = PF0, 10 = PF1, 11 = PF2 or PF3 if inverse */
+		for (i = 0; i < 2; i++)
+			for (j = 0; j < 16; j++)
+				glyph_pair(&glyph_pairs_4[i][j], glyph_key_mc[j >> 2 == 3 ? 3 + i : j >> 2],
+					glyph_key_mc[(j & 3) == 3 ? 3 + i : j & 3]);
+		/* 6/7: 0 = BAK, 1 = PF0..PF3 from the top bits of the character */
+		for (i = 0; i < 4; i++)
+			for (j = 0; j < 4; j++)
+				glyph_pair(&glyph_pairs_6[i][j], glyph_key_mc[j & 2 ? i + 1 : 0],
+					glyph_key_mc[j & 1 ? i + 1 : 0]);
+	}
+}
+
+#define DRAW_GLYPH_ROW(pairs, data) {\
+		WRITE_VIDEO_LONG_UNALIGNED((ULONG *) ptr, (pairs)[(data) >> 4]);\
+		WRITE_VIDEO_LONG_UNALIGNED(((ULONG *) ptr) + 1, (pairs)[(data) & 0x0f]);\
+		ptr += 4;\
+	}
+
 static void draw_antic_2(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr)
 {
 	INIT_BACKGROUND_6
 	INIT_ANTIC_2
 	INIT_HIRES
 
+	glyph_check_2();
 	CHAR_LOOP_BEGIN
 		UBYTE screendata = *ANTIC_memptr++;
 		int chdata;
 
 		GET_CHDATA_ANTIC_2
-		if (IS_ZERO_ULONG(t_pm_scanline_ptr)) {
-			if (chdata) {
-				WRITE_VIDEO(ptr++, hires_norm(chdata & 0xc0));
-				WRITE_VIDEO(ptr++, hires_norm(chdata & 0x30));
-				WRITE_VIDEO(ptr++, hires_norm(chdata & 0x0c));
-				WRITE_VIDEO(ptr++, hires_norm((chdata & 0x03) << 2));
-			}
-			else
-				DRAW_BACKGROUND(C_PF2)
-		}
+		if (IS_ZERO_ULONG(t_pm_scanline_ptr))
+			DRAW_GLYPH_ROW(glyph_pairs_2, chdata)
 		else
 			DO_PMG_HIRES(chdata)
 		t_pm_scanline_ptr++;
@@ -1363,36 +1562,22 @@ static void draw_antic_2_gtia11(int nchars, const UBYTE *ANTIC_memptr, UWORD *pt
 
 static void draw_antic_4(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr)
 {
-	INIT_BACKGROUND_8
 	const UBYTE *chptr = memory + (((anticmode == 4 ? dctr : dctr >> 1) ^ chbase_20) & 0xfc07);
 
 	ADD_FONT_CYCLES;
-	lookup2[0x0f] = lookup2[0x00] = cl_lookup[C_BAK];
-	lookup2[0x4f] = lookup2[0x1f] = lookup2[0x13] =
-	lookup2[0x40] = lookup2[0x10] = lookup2[0x04] = lookup2[0x01] = cl_lookup[C_PF0];
-	lookup2[0x8f] = lookup2[0x2f] = lookup2[0x17] = lookup2[0x11] =
-	lookup2[0x80] = lookup2[0x20] = lookup2[0x08] = lookup2[0x02] = cl_lookup[C_PF1];
-	lookup2[0xc0] = lookup2[0x30] = lookup2[0x0c] = lookup2[0x03] = cl_lookup[C_PF2];
-	lookup2[0xcf] = lookup2[0x3f] = lookup2[0x1b] = lookup2[0x12] = cl_lookup[C_PF3];
+	glyph_check_mc();
 
 	CHAR_LOOP_BEGIN
 		UBYTE screendata = *ANTIC_memptr++;
-		const UWORD *lookup;
 		UBYTE chdata;
-		if (screendata & 0x80)
-			lookup = lookup2 + 0xf;
-		else
-			lookup = lookup2;
 		chdata = chptr[(screendata & 0x7f) << 3];
-		if (IS_ZERO_ULONG(t_pm_scanline_ptr)) {
-			if (chdata) {
-				WRITE_VIDEO(ptr++, lookup[chdata & 0xc0]);
-				WRITE_VIDEO(ptr++, lookup[chdata & 0x30]);
-				WRITE_VIDEO(ptr++, lookup[chdata & 0x0c]);
-				WRITE_VIDEO(ptr++, lookup[chdata & 0x03]);
-			}
-			else
-				DRAW_BACKGROUND(C_BAK)
+		if (IS_ZERO_ULONG(t_pm_scanline_ptr))
+			DRAW_GLYPH_ROW(glyph_pairs_4[screendata >> 7], chdata)
+		else if (chdata == (chdata & 0x03) * 0x55) {
+			int colreg;
+			playfield_lookup[0xc0] = screendata & 0x80 ? L_PF3 : L_PF2;
+			colreg = playfield_lookup[chdata & 0xc0];
+			DO_PMG_LORES_GROUP(colreg)
 		}
 		else {
 			const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;
@@ -1441,47 +1626,23 @@ static void draw_antic_6(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, cons
 	const UBYTE *chptr = memory + ((anticmode == 6 ? dctr & 7 : dctr >> 1) ^ chbase_20);
 
 	ADD_FONT_CYCLES;
+	glyph_check_mc();
 	CHAR_LOOP_BEGIN
 		UBYTE screendata = *ANTIC_memptr++;
 		UBYTE chdata;
-		UWORD colour;
 		int kk = 2;
-		colour = COLOUR((playfield_lookup + 0x40)[screendata & 0xc0]);
 		chdata = chptr[(screendata & 0x3f) << 3];
 		do {
 			if (IS_ZERO_ULONG(t_pm_scanline_ptr)) {
-				if (chdata & 0xf0) {
-					if (chdata & 0x80) {
-						WRITE_VIDEO(ptr++, colour);
-					}
-					else {
-						WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					}
-					if (chdata & 0x40) {
-						WRITE_VIDEO(ptr++, colour);
-					}
-					else {
-						WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					}
-					if (chdata & 0x20) {
-						WRITE_VIDEO(ptr++, colour);
-					}
-					else {
-						WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					}
-					if (chdata & 0x10) {
-						WRITE_VIDEO(ptr++, colour);
-					}
-					else {
-						WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					}
-				}
-				else {
-					WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-					WRITE_VIDEO(ptr++, cl_lookup[C_BAK]);
-				}
+				const ULONG *pairs = glyph_pairs_6[screendata >> 6];
+				WRITE_VIDEO_LONG_UNALIGNED((ULONG *) ptr, pairs[chdata >> 6]);
+				WRITE_VIDEO_LONG_UNALIGNED(((ULONG *) ptr) + 1, pairs[(chdata >> 4) & 3]);
+				ptr += 4;
+				chdata <<= 4;
+			}
+			else if ((chdata & 0xf0) == 0 || (chdata & 0xf0) == 0xf0) {
+				int colreg = chdata & 0x80 ? (playfield_lookup + 0x40)[screendata & 0xc0] : L_BAK;
+				DO_PMG_LORES_GROUP(colreg)
 				chdata <<= 4;
 			}
 			else {
@@ -1546,13 +1707,8 @@ static void draw_antic_8(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, cons
 				WRITE_VIDEO(ptr++, data);
 			}
 			else {
-				const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;
-				int pm_pixel;
 				int colreg = playfield_lookup[screendata & 0xc0];
-				int k = 4;
-				do {
-					DO_PMG_LORES
-				} while (--k);
+				DO_PMG_LORES_GROUP(colreg)
 			}
 			screendata <<= 2;
 			t_pm_scanline_ptr++;
@@ -1597,6 +1753,11 @@ static void draw_antic_9(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, cons
 				WRITE_VIDEO(ptr++, lookup2[screendata & 0x40]);
 				screendata <<= 2;
 			}
+			else if (((screendata ^ (screendata << 1)) & 0x80) == 0) {
+				int colreg = (screendata & 0x80) ? L_PF0 : L_BAK;
+				DO_PMG_LORES_GROUP(colreg)
+				screendata <<= 2;
+			}
 			else {
 				const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;
 				int pm_pixel;
@@ -1649,6 +1810,11 @@ static void draw_antic_a(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, cons
 				WRITE_VIDEO(ptr++, lookup2[screendata & 0x30]);
 				screendata <<= 4;
 			}
+			else if (((screendata ^ (screendata << 2)) & 0xc0) == 0) {
+				int colreg = playfield_lookup[screendata & 0xc0];
+				DO_PMG_LORES_GROUP(colreg)
+				screendata <<= 4;
+			}
 			else {
 				const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;
 				int pm_pixel;
@@ -1704,6 +1870,11 @@ static void draw_antic_c(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, cons
 				WRITE_VIDEO(ptr++, lookup2[screendata & 0x10]);
 				screendata <<= 4;
 			}
+			else if ((screendata & 0xf0) == 0 || (screendata & 0xf0) == 0xf0) {
+				int colreg = (screendata & 0x80) ? L_PF0 : L_BAK;
+				DO_PMG_LORES_GROUP(colreg)
+				screendata <<= 4;
+			}
 			else {
 				const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;
 				int pm_pixel;
@@ -1741,6 +1912,10 @@ static void draw_antic_e(int nchars, const UBYTE *ANTIC_memptr, UWORD *ptr, cons
 			else
 				DRAW_BACKGROUND(C_BAK)
 		}
+		else if (screendata == (screendata & 0x03) * 0x55) {
+			int colreg = playfield_lookup[screendata & 0xc0];
+			DO_PMG_LORES_GROUP(colreg)
+		}
 		else {
 			const UBYTE *c_pm_scanline_ptr = (const UBYTE *) t_pm_scanline_ptr;
 			int pm_pixel;
@@ -2246,8 +2421,10 @@ void ANTIC_Frame(void) {
 	};
 	static const UBYTE normal_lastline[16] =
 		{ 0, 0, 7, 9, 7, 15, 7, 15, 7, 3, 3, 1, 0, 1, 0, 0 };
+	static const UBYTE char_width[6] = { 4, 8, 16, 4, 8, 16 };
 	UBYTE vscrol_flag = FALSE;
 	UBYTE no_jvb = TRUE;
+	UBYTE skip_line;
 #ifndef NEW_CYCLE_EXACT
 	UBYTE need_load;
 #endif
@@ -2268,18 +2445,24 @@ void ANTIC_Frame(void) {
 #endif /* NO_GTIA11_DELAY */
 
 	ypos = 0;
+	if (antic_trace_hook)
+		antic_trace_hook(ypos);
 	do {
 		POKEY_Scanline(); /* check and generate IRQ */
 		OVERSCREEN_LINE;
 	} while (ypos < 8);
 
-	scrn_ptr = (UWORD *)a5200_screen_buffer;
-
 #ifdef NEW_CYCLE_EXACT
 	cur_screen_pos = NOT_DRAWING;
 #endif
 	need_dl = TRUE;
 	do {
+		/* lines outside the render window go to the scratch line */
+		skip_line = (ypos - 8 < render_top || ypos - 8 >= render_bottom);
+		scrn_ptr = (UWORD *) (a5200_screen_buffer +
+			(skip_line ? 0 : (ypos - 8 - render_top + 1) * ANTIC_SCREEN_PITCH));
+		skip_line |= antic_skip_render;
+
 		POKEY_Scanline(); /* check and generate IRQ */
 		pmg_dma();
 
@@ -2426,7 +2609,7 @@ void ANTIC_Frame(void) {
 				NMIST = 0x9f;
 				if (NMIEN & 0x80) {
 					GO(NMI_C);
-					NMI();
+					antic_nmi(ANTIC_LINE_DLI);
 				}
 			}
 		}
@@ -2450,7 +2633,6 @@ void ANTIC_Frame(void) {
 			UPDATE_DMACTL
 			cur_screen_pos = NOT_DRAWING;
 			YPOS_BREAK_FLICKER
-      scrn_ptr += 256;
 			if (no_jvb) {
 				dctr++;
 				dctr &= 0xf;
@@ -2473,10 +2655,10 @@ void ANTIC_Frame(void) {
 		xpos += DMAR;
 
 		if (anticmode < 2 || (DMACTL & 3) == 0) {
-			draw_antic_0_ptr();
+			if (!skip_line)
+				draw_antic_0_ptr();
 			GOEOL;
 			YPOS_BREAK_FLICKER
-      scrn_ptr += 256;
 			if (no_jvb) {
 				dctr++;
 				dctr &= 0xf;
@@ -2491,10 +2673,38 @@ void ANTIC_Frame(void) {
 				xpos -= extra_cycles[md];
 		}
 
-		draw_antic_ptr(chars_displayed[md],
-			ANTIC_memory + ANTIC_margin + ch_offset[md],
-			scrn_ptr + x_min[md],
-			(ULONG *) &pm_scanline[x_min[md]]);
+		/* PF->PM collisions are only detected by the draw functions,
+		   so lines with PMG data are always drawn in full */
+		if (pm_dirty)
+			draw_antic_ptr(chars_displayed[md],
+				ANTIC_memory + ANTIC_margin + ch_offset[md],
+				scrn_ptr + x_min[md],
+				(ULONG *) &pm_scanline[x_min[md]]);
+		else if (!skip_line) {
+			/* don't draw characters outside the render window. The
+			   artifacting routines take the colour of the first drawn
+			   character from the byte before it, so they draw all */
+			int nchars = chars_displayed[md];
+			int x = x_min[md];
+			int skip = 0;
+			if (PRIOR < 0x40 && draw_antic_ptr != draw_antic_f_gtia_bug &&
+				draw_antic_ptr != draw_antic_2_artif && draw_antic_ptr != draw_antic_f_artif) {
+				int width = char_width[md];
+				int lskip = x < LBORDER_START ? (LBORDER_START - x) / width : 0;
+				int rskip = x + nchars * width > RBORDER_END ? (x + nchars * width - RBORDER_END) / width : 0;
+				if (nchars > lskip + rskip) {
+					skip = lskip;
+					x += skip * width;
+					nchars -= lskip + rskip;
+				}
+			}
+			draw_antic_ptr(nchars,
+				ANTIC_memory + ANTIC_margin + ch_offset[md] + skip,
+				scrn_ptr + x,
+				(ULONG *) &pm_scanline[x]);
+		}
+		else if (anticmode <= 7)
+			ADD_FONT_CYCLES;	/* normally done by draw_antic_2..7 */
 
 #endif /* NEW_CYCLE_EXACT */
 #ifndef NO_GTIA11_DELAY
@@ -2502,7 +2712,7 @@ void ANTIC_Frame(void) {
 		if (PRIOR >= 0xc0)
 			delayed_gtia11 = ypos + 1;
 		else
-			if (ypos == delayed_gtia11) {
+			if (ypos == delayed_gtia11 && !skip_line) {
 				ULONG *ptr = (ULONG *) (scrn_ptr + 4 * LCHOP);
 				int k = 2 * (48 - LCHOP - RCHOP);
 				do {
@@ -2601,7 +2811,6 @@ void ANTIC_Frame(void) {
 		GOEOL;
 #endif /* NEW_CYCLE_EXACT */
 		YPOS_BREAK_FLICKER
-      scrn_ptr += 256;
 		dctr++;
 		dctr &= 0xf;
 	} while (ypos < (ATARI_HEIGHT + 8));
@@ -2612,7 +2821,7 @@ void ANTIC_Frame(void) {
 	NMIST = 0x5f;				/* Set VBLANK */
 	if (NMIEN & 0x40) {
 		GO(NMI_C);
-		NMI();
+		antic_nmi(ANTIC_LINE_VBI);
 	}
 	xpos += DMAR;
 	GOEOL;
@@ -2621,6 +2830,8 @@ void ANTIC_Frame(void) {
 	  POKEY_Scanline();		/* check and generate IRQ */
 		OVERSCREEN_LINE;
 	} while (ypos < max_ypos);
+	if (antic_trace_hook)
+		antic_trace_hook(ypos);
 	ypos = 0; /* just for monitor.c */
 }
 
@@ -2729,11 +2940,11 @@ void draw_partial_scanline(int l, int r)
 	int rborder_start = right_border_start;
 
 	/* lborder_start: start of the left border, in words */
-	int lborder_start = LCHOP * 4;
+	int lborder_start = render_left;
 	/* end of the left border, in words */
-	int lborder_end = LCHOP * 4 + left_border_chars * 4;
+	int lborder_end = render_left + left_border_chars * 4;
 	/* end of the right border, in words */
-	int rborder_end = (48 - RCHOP) * 4;
+	int rborder_end = render_right;
 	/* flag: if true, don't show playfield. used if the partial scanline */
 	/*    does not include the playfield */
 	int dont_display_playfield = 0;
@@ -2916,8 +3127,8 @@ void draw_partial_scanline(int l, int r)
 	/* restore border global variables */
 	left_border_chars=lborder_chars;
 	right_border_start=rborder_start;
-	left_border_start = LCHOP * 4;
-	right_border_end = (48-RCHOP)  *4;
+	left_border_start = render_left;
+	right_border_end = render_right;
 }
 #endif /* NEW_CYCLE_EXACT */
 
@@ -3030,6 +3241,14 @@ void set_prior(UBYTE byte)
 
 void ANTIC_PutByte(UWORD addr, UBYTE byte)
 {
+	REGISTER_STAT_INC(antic_write_stat, addr & 0xf);
+	if (write_shadow[addr & 0xf] == byte) {
+		REGISTER_STAT_INC(antic_elided_write_stat, addr & 0xf);
+		return;
+	}
+	if ((ELIDABLE_REGS >> (addr & 0xf)) & 1)
+		write_shadow[addr & 0xf] = byte;
+
 	switch (addr & 0xf) {
 	case _DLISTL:
 		dlist = (dlist & 0xff00) | byte;
@@ -3154,7 +3373,8 @@ glitch */
 			before_cycles[SCROLL0] = BEFORE_CYCLES + 8;
 			extra_cycles[NORMAL0] = 7 + BEFORE_CYCLES;
 			extra_cycles[SCROLL0] = 8 + BEFORE_CYCLES + 8;
-			left_border_chars = 8 - LCHOP;
+			playfield_start = 32;
+			UPDATE_LEFT_BORDER_CHARS
 			right_border_start = (ATARI_WIDTH - 64) / 2;
 			break;
 		case 0x02:
@@ -3180,7 +3400,8 @@ glitch */
 			before_cycles[SCROLL0] = BEFORE_CYCLES + 16;
 			extra_cycles[NORMAL0] = 8 + BEFORE_CYCLES + 8;
 			extra_cycles[SCROLL0] = 7 + BEFORE_CYCLES + 16;
-			left_border_chars = 4 - LCHOP;
+			playfield_start = 16;
+			UPDATE_LEFT_BORDER_CHARS
 			right_border_start = (ATARI_WIDTH - 32) / 2;
 			break;
 		case 0x03:
@@ -3206,7 +3427,8 @@ glitch */
 			before_cycles[SCROLL0] = BEFORE_CYCLES + 16;
 			extra_cycles[NORMAL0] = 7 + BEFORE_CYCLES + 16;
 			extra_cycles[SCROLL0] = 7 + BEFORE_CYCLES + 16;
-			left_border_chars = 3 - LCHOP;
+			playfield_start = 12;
+			UPDATE_LEFT_BORDER_CHARS
 			right_border_start = (ATARI_WIDTH - 8) / 2;
 			break;
 		}
@@ -3379,6 +3601,9 @@ case we have cpu2antic_ptr[WSYNC_C+1]-1 = 8 and in the 2nd =12  */
 		else {
 			delayed_wsync = 0;
 #endif /* NEW_CYCLE_EXACT */
+			if (antic_collect_line_stats)
+				antic_line_wsync_cycles += (xpos <= WSYNC_C && xpos_limit >= WSYNC_C
+					? WSYNC_C : xpos_limit) - xpos;
 			if (xpos <= WSYNC_C && xpos_limit >= WSYNC_C)
 				xpos = WSYNC_C;
 			else {
@@ -3448,6 +3673,7 @@ void AnticStateRead(void) {
 	ReadINT(&xpos_limit, 1);
 	ReadINT(&ypos, 1);
 
+	reset_write_shadow();
 	ANTIC_PutByte(_DMACTL, DMACTL);
 	ANTIC_PutByte(_CHACTL, CHACTL);
 	ANTIC_PutByte(_PMBASE, PMBASE);
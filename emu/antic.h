@@ -45,6 +45,43 @@ extern UBYTE wsync_halt;
 
 extern int global_artif_mode;
 
+/* set before ANTIC_Frame to skip pixel generation for that frame */
+extern int antic_skip_render;
+
+/* Per-scanline cycle accounting. While antic_collect_line_stats is set,
+   ANTIC_Frame fills ANTIC_line_stats[ypos] for each of the max_ypos lines
+   of the frame (not collected in NEW_CYCLE_EXACT builds). The cycles of a
+   line add up to LINE_C, give or take the cycles of the instructions that
+   cross the line boundary. */
+#define ANTIC_LINE_STATS_MAX 312	/* max_ypos of PAL */
+
+#define ANTIC_LINE_DLI	0x01	/* DLI executed on this line */
+#define ANTIC_LINE_VBI	0x02	/* VBI executed on this line */
+
+typedef struct {
+	UBYTE dma_cycles;		/* stolen by ANTIC (DL, screen, PM DMA, refresh) */
+	UBYTE cpu_cycles;		/* executed by the CPU, incl. interrupt entry */
+	UBYTE wsync_cycles;		/* CPU halted by a WSYNC write */
+	UBYTE nmi;				/* ANTIC_LINE_DLI | ANTIC_LINE_VBI */
+} ANTIC_line_stat;
+
+extern int antic_collect_line_stats;
+extern ANTIC_line_stat ANTIC_line_stats[ANTIC_LINE_STATS_MAX];
+
+/* counters of the current line, advanced by GO() and WSYNC */
+extern int antic_line_cpu_cycles;
+extern int antic_line_wsync_cycles;
+
+/* returns ANTIC_line_stats, setting *lines to the number of lines in
+   a frame */
+const ANTIC_line_stat *ANTIC_GetLineStats(int *lines);
+
+/* If set, called by ANTIC_Frame at the start of the frame (ypos 0), at the
+   start of each band of ANTIC_TRACE_BAND_LINES scanlines, and at the end of
+   the frame (ypos == max_ypos) - for timing the frame in bands */
+#define ANTIC_TRACE_BAND_LINES 32
+extern void (*antic_trace_hook)(int ypos);
+
 extern UBYTE PENH_input;
 extern UBYTE PENV_input;
 
@@ -60,6 +97,17 @@ UWORD ANTIC_GetDLWord(UWORD *paddr);
 /* always call ANTIC_UpdateArtifacting after changing global_artif_mode */
 void ANTIC_UpdateArtifacting(void);
 
+/* Screen buffer layout: ANTIC_SCREEN_PITCH bytes per line. The first line
+   is a scratch line for scanlines outside the render window, followed by
+   the lines of the render window. */
+#define ANTIC_SCREEN_PITCH ATARI_WIDTH
+#define ANTIC_SCREEN_BUFFER_SIZE(height) (((height) + 1) * ANTIC_SCREEN_PITCH)
+
+/* Only draw the part of the ATARI_WIDTH x ATARI_HEIGHT screen seen through
+   the given window (x and width in multiples of 8 pixels). Collisions are
+   still detected over the full width. */
+void ANTIC_SetRenderWindow(int x, int y, int width, int height);
+
 /* Video memory access */
 void video_memset(UBYTE *ptr, UBYTE val, ULONG size);
 void video_putbyte(UBYTE *ptr, UBYTE val);
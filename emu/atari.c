@@ -56,6 +56,7 @@
 
 #include "memory.h"
 #include "pia.h"
+#include "pokey.h"
 #include "pokeysnd.h"
 #include "rtime8.h"
 #include "sio.h"
@@ -74,6 +75,7 @@ int start_binloading = FALSE;
 int hold_start = 0;
 int press_space = 0;
 int tv_mode = TV_NTSC;
+int sound_sample_rate = SOUND_SAMPLE_RATE;
 
 /* Now we check address of every escape code, to make sure that the patch
    has been set by the emulator and is not a CIM in Atari program.
@@ -277,11 +279,19 @@ void Atari800_Initialise(void)
 
 UNALIGNED_STAT_DEF(atari_screen_write_long_stat)
 UNALIGNED_STAT_DEF(pm_scanline_read_long_stat)
+UNALIGNED_STAT_DEF(pm_scanline_write_long_stat)
 UNALIGNED_STAT_DEF(memory_read_word_stat)
 UNALIGNED_STAT_DEF(memory_write_word_stat)
 UNALIGNED_STAT_DEF(memory_read_aligned_word_stat)
 UNALIGNED_STAT_DEF(memory_write_aligned_word_stat)
 
+REGISTER_STAT_DEF(antic_write_stat, 16)
+REGISTER_STAT_DEF(antic_elided_write_stat, 16)
+REGISTER_STAT_DEF(gtia_write_stat, 32)
+REGISTER_STAT_DEF(gtia_elided_write_stat, 32)
+REGISTER_STAT_DEF(pokey_write_stat, 32)
+REGISTER_STAT_DEF(pokey_elided_write_stat, 32)
+
 int Atari800_Exit(void) {
 	SIO_Exit(); /* umount disks, so temporary files are deleted */
 	return 0;
@@ -415,17 +425,43 @@ void MainStateRead(void) {
 /* -------------------------------------------------------------------------- */
 /* CONFIG & INITIALISATION                                                    */
 /* -------------------------------------------------------------------------- */
+#ifdef SOUND
+static void init_sound(void)
+{
+#ifdef STEREO_SOUND
+  Pokey_sound_init(FREQ_17_EXACT, sound_sample_rate, 2, 0);
+#else
+  /* 16-bit samples, duplicated to the stereo output of the frontend */
+  Pokey_sound_init(FREQ_17_EXACT, sound_sample_rate, 1,
+        POKEYSND_BIT16 | POKEYSND_STEREO);
+#endif
+}
+#endif
+
+void Atari800_SetSampleRate(int rate)
+{
+   if (rate == sound_sample_rate)
+      return;
+
+   sound_sample_rate = rate;
+   Atari800_RestartSound();
+}
+
+void Atari800_RestartSound(void)
+{
+#ifdef SOUND
+   init_sound();
+   POKEY_RestoreSound();
+#endif
+}
+
 void Atari_Initialise(void)
 {
    unsigned i;
 
 #ifdef SOUND
    /* Initialise sound routines */
-#ifdef STEREO_SOUND
-  Pokey_sound_init(FREQ_17_EXACT, SOUND_SAMPLE_RATE, 2, 0);
-#else
-  Pokey_sound_init(FREQ_17_EXACT, SOUND_SAMPLE_RATE, 1, 0);
-#endif
+   init_sound();
 #endif
 
    for (i = 0; i < 4; i++)
@@ -55,7 +55,11 @@ extern int tv_mode;
 #define ATARI_WIDTH  384
 #define ATARI_HEIGHT 240
 
+/* Default audio sample rate */
 #define SOUND_SAMPLE_RATE 44100
+/* Audio sample rate in use. Set it before Atari800_Initialise(),
+   or change it later with Atari800_SetSampleRate() */
+extern int sound_sample_rate;
 
 /* File types returned by Atari800_DetectFileType() and Atari800_OpenFile(). */
 #define AFILE_ERROR      0
@@ -80,6 +84,15 @@ void Atari800_Initialise(void);
 /* Emulates one frame (1/50sec for PAL, 1/60sec for NTSC). */
 void Atari800_Frame(void);
 
+/* Reinitialises the sound emulation at the given sample rate,
+   keeping the current state of the POKEY audio registers. */
+void Atari800_SetSampleRate(int rate);
+
+/* Reinitialises the sound emulation with the current settings (e.g. after
+   POKEYSND_enable_new_pokey is changed), keeping the current state of the
+   POKEY audio registers. */
+void Atari800_RestartSound(void);
+
 /* Reboots the emulated Atari. */
 void Coldstart(void);
 
@@ -158,6 +171,7 @@ extern unsigned int screenline_cpu_clock;
 #define UNALIGNED_PUT_LONG(ptr, value, stat_arr) (stat_arr[(unsigned int) (ptr) & 7]++, *(ULONG *) (ptr) = (value))
 UNALIGNED_STAT_DECL(atari_screen_write_long_stat)
 UNALIGNED_STAT_DECL(pm_scanline_read_long_stat)
+UNALIGNED_STAT_DECL(pm_scanline_write_long_stat)
 UNALIGNED_STAT_DECL(memory_read_word_stat)
 UNALIGNED_STAT_DECL(memory_write_word_stat)
 UNALIGNED_STAT_DECL(memory_read_aligned_word_stat)
@@ -171,6 +185,29 @@ UNALIGNED_STAT_DECL(memory_write_aligned_word_stat)
 #define UNALIGNED_PUT_LONG(ptr, value, stat_arr) (*(ULONG *) (ptr) = (value))
 #endif
 
+/* STAT_REGISTER_WRITES is solely for benchmarking purposes.
+   Arrays (stat_arr) represent number of writes to each hardware register,
+   and how many of them were skipped because they rewrote the current value
+   of a register without side effects. */
+#ifdef STAT_REGISTER_WRITES
+#define REGISTER_STAT_DEF(stat_arr, size)        unsigned int stat_arr[size];
+#define REGISTER_STAT_DECL(stat_arr, size)       extern unsigned int stat_arr[size];
+#define REGISTER_STAT_INC(stat_arr, reg)         (stat_arr[reg]++)
+REGISTER_STAT_DECL(antic_write_stat, 16)
+REGISTER_STAT_DECL(antic_elided_write_stat, 16)
+REGISTER_STAT_DECL(gtia_write_stat, 32)
+REGISTER_STAT_DECL(gtia_elided_write_stat, 32)
+REGISTER_STAT_DECL(pokey_write_stat, 32)
+REGISTER_STAT_DECL(pokey_elided_write_stat, 32)
+#else
+#define REGISTER_STAT_DEF(stat_arr, size)
+#define REGISTER_STAT_DECL(stat_arr, size)
+#define REGISTER_STAT_INC(stat_arr, reg)
+#endif
+
+/* Value of a write shadow entry that matches no written byte */
+#define WRITE_SHADOW_INVALID 0xffff
+
 /* Escape codes used to mark places in 6502 code that must
    be handled specially by the emulator. An escape sequence
    is an illegal 6502 opcode 0xF2 or 0xD2 followed
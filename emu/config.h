@@ -6,7 +6,9 @@
 #define INTERPOLATE_SOUND 1
 #define VOL_ONLY_SOUND 1
 #define CONSOLE_SOUND 1
-//#define SYNCHRONIZED_SOUND 1
+// Define to generate sound as the frame is emulated, so that sound
+// register writes take effect at the CPU cycle they occur.
+#define SYNCHRONIZED_SOUND 1
 
 /* retro_endianness.h defines WORDS_BIGENDIAN if necessarry.  */
 #include <retro_endianness.h>
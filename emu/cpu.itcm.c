@@ -408,6 +408,9 @@ void GO(int limit)
 	UBYTE data;
 #define insn data
 
+	int start_xpos;				/* for the per-scanline statistics */
+	int start_wsync_cycles;
+
 /*
    This used to be in the main loop but has been removed to improve
    execution speed. It does not seem to have any adverse effect on
@@ -444,6 +447,8 @@ void GO(int limit)
 
 		if (limit < WSYNC_C)
 			return;
+		if (antic_collect_line_stats)
+			antic_line_wsync_cycles += WSYNC_C - xpos;
 		xpos = WSYNC_C;
 
 #endif /* NEW_CYCLE_EXACT */
@@ -451,6 +456,8 @@ void GO(int limit)
 		wsync_halt = 0;
 	}
 	xpos_limit = limit;			/* needed for WSYNC store inside ANTIC */
+	start_xpos = xpos;
+	start_wsync_cycles = antic_line_wsync_cycles;
 
 	UPDATE_LOCAL_REGS;
 
@@ -1965,6 +1972,11 @@ void GO(int limit)
 	}
 
 	UPDATE_GLOBAL_REGS;
+
+	/* cycles skipped by WSYNC writes don't count as executed */
+	if (antic_collect_line_stats)
+		antic_line_cpu_cycles += xpos - start_xpos
+			- (antic_line_wsync_cycles - start_wsync_cycles);
 }
 
 void CPU_Initialise(void)
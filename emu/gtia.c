@@ -132,6 +132,9 @@ static ULONG hposp_mask[4];
 
 static ULONG grafp_lookup[4][256];
 static ULONG *grafp_ptr[4];
+/* 0xff in byte i for each set bit i, used to update 4 bytes
+   of pm_scanline at once */
+static ULONG pm_lane_mask[16];
 static int global_sizem[4];
 
 static const UBYTE PM_Width[4] = {1, 2, 1, 4};
@@ -196,10 +199,34 @@ void setup_gtia9_11(void) {
 	}
 }
 
+/* Redundant writes -------------------------------------------------------- */
+
+/* Registers whose writes only update state derived from the value written,
+   so that rewriting the current value has no effect: HPOSPx, HPOSMx, SIZEPx,
+   SIZEM, COLPMx, COLPFx, COLBK and PRIOR. GRAFPx and GRAFM are excluded,
+   as they are also updated by player/missile DMA. */
+#ifdef NEW_CYCLE_EXACT
+/* PRIOR writes are also recorded in the prior change buffer */
+#define ELIDABLE_REGS 0x07fc1fffUL
+#else
+#define ELIDABLE_REGS 0x0ffc1fffUL
+#endif
+
+/* Last value written to each of the above registers */
+static UWORD write_shadow[32];
+
+static void reset_write_shadow(void)
+{
+	int i;
+	for (i = 0; i < 32; i++)
+		write_shadow[i] = WRITE_SHADOW_INVALID;
+}
+
 /* Initialization ---------------------------------------------------------- */
 
 void GTIA_Initialise(void) {
 	int i;
+	reset_write_shadow();
 	for (i = 0; i < 256; i++) {
 		int tmp = i + 0x100;
 		ULONG grafp1 = 0;
@@ -220,6 +247,13 @@ void GTIA_Initialise(void) {
 		grafp_lookup[1][i] = grafp2;
 		grafp_lookup[3][i] = grafp4;
 	}
+	for (i = 0; i < 16; i++) {
+		UBYTE lanes[4];
+		int j;
+		for (j = 0; j < 4; j++)
+			lanes[j] = (i >> j) & 1 ? 0xff : 0;
+		memcpy(&pm_lane_mask[i], lanes, sizeof(lanes));
+	}
 	memset(cl_lookup, COLOUR_BLACK, sizeof(cl_lookup));
 	for (i = 0; i < 32; i++)
 		GTIA_PutByte((UWORD) i, 0);
@@ -314,17 +348,32 @@ void new_pm_scanline(void)
 
 /* Draw Players */
 
+/* Players and missiles are drawn 4 bytes at a time. A group starts at
+   the first pixel, so it can only extend past the last pixel, which
+   is at most pm_scanline[ATARI_WIDTH / 2 - 3]. The collisions with
+   the bytes under the pixels are OR-ed together in colls. */
+
+#define OR_BYTES(x) ((UBYTE) ((x) | ((x) >> 8) | ((x) >> 16) | ((x) >> 24)))
+
 #define DO_PLAYER(n)	if (GRAFP##n) {						\
 	ULONG grafp = grafp_ptr[n][GRAFP##n] & hposp_mask[n];	\
 	if (grafp) {											\
 		UBYTE *ptr = hposp_ptr[n];							\
+		ULONG colls = 0;									\
 		pm_dirty = TRUE;									\
-		do {												\
-			if (grafp & 1)									\
-				P##n##PL_T |= *ptr |= 1 << n;					\
+		while (!(grafp & 1)) {								\
 			ptr++;											\
 			grafp >>= 1;									\
+		}													\
+		do {												\
+			ULONG mask = pm_lane_mask[grafp & 0xf];			\
+			ULONG data = UNALIGNED_GET_LONG(ptr, pm_scanline_read_long_stat);	\
+			colls |= data & mask;							\
+			UNALIGNED_PUT_LONG(ptr, data | (mask & (0x01010101 << n)), pm_scanline_write_long_stat);	\
+			ptr += 4;										\
+			grafp >>= 4;									\
 		} while (grafp);									\
+		P##n##PL_T |= OR_BYTES(colls) | (1 << n);			\
 	}														\
 }
 
@@ -334,11 +383,14 @@ void new_pm_scanline(void)
 		if (grafp) {
 			UBYTE *ptr = hposp_ptr[0];
 			pm_dirty = TRUE;
-			do {
-				if (grafp & 1)
-					*ptr = 1;
+			while (!(grafp & 1)) {
 				ptr++;
 				grafp >>= 1;
+			}
+			do {
+				UNALIGNED_PUT_LONG(ptr, pm_lane_mask[grafp & 0xf] & 0x01010101, pm_scanline_write_long_stat);
+				ptr += 4;
+				grafp >>= 4;
 			} while (grafp);
 		}
 	}
@@ -364,10 +416,22 @@ void new_pm_scanline(void)
 	}												\
 	else if (ptr + j > pm_scanline + ATARI_WIDTH / 2 - 2)	\
 		j = pm_scanline + ATARI_WIDTH / 2 - 2 - ptr;		\
-	if (j > 0)										\
-		do											\
-			M##n##PL_T |= *ptr++ |= p;				\
-		while (--j);								\
+	if (j > 0) {									\
+		ULONG colls = 0;							\
+		ULONG data;									\
+		for (; j >= 4; j -= 4, ptr += 4) {			\
+			data = UNALIGNED_GET_LONG(ptr, pm_scanline_read_long_stat);	\
+			colls |= data;							\
+			UNALIGNED_PUT_LONG(ptr, data | (p * 0x01010101), pm_scanline_write_long_stat);	\
+		}											\
+		if (j > 0) {								\
+			ULONG mask = pm_lane_mask[(1 << j) - 1];	\
+			data = UNALIGNED_GET_LONG(ptr, pm_scanline_read_long_stat);	\
+			colls |= data & mask;					\
+			UNALIGNED_PUT_LONG(ptr, data | (mask & (p * 0x01010101)), pm_scanline_write_long_stat);	\
+		}											\
+		M##n##PL_T |= OR_BYTES(colls) | p;			\
+	}												\
 }
 
 	if (GRAFM) {
@@ -520,6 +584,14 @@ void GTIA_PutByte(UWORD addr, UBYTE byte)
 #define UPDATE_PM_CYCLE_EXACT
 #endif
 
+	REGISTER_STAT_INC(gtia_write_stat, addr & 0x1f);
+	if (write_shadow[addr & 0x1f] == byte) {
+		REGISTER_STAT_INC(gtia_elided_write_stat, addr & 0x1f);
+		return;
+	}
+	if ((ELIDABLE_REGS >> (addr & 0x1f)) & 1)
+		write_shadow[addr & 0x1f] = byte;
+
 	switch (addr & 0x1f) {
 	case _CONSOL:
 		atari_speaker = !(byte & 0x08);
@@ -973,6 +1045,7 @@ void GTIAStateRead(void)
 	ReadINT(&atari_speaker, 1);
 	ReadINT(&next_console_value, 1);
 
+	reset_write_shadow();
 	GTIA_PutByte(_HPOSP0, HPOSP0);
 	GTIA_PutByte(_HPOSP1, HPOSP1);
 	GTIA_PutByte(_HPOSP2, HPOSP2);
@@ -24,6 +24,7 @@
 
 #include "config.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "atari.h"
@@ -32,6 +33,7 @@
 #include "remez.h"
 #include "antic.h"
 #include "gtia.h"
+#include "mzpokeysnd_filters.h"
 
 #define CONSOLE_VOL 8
 #ifdef NONLINEAR_MIXING
@@ -70,7 +72,18 @@ static int num_cur_pokeys = 0;
 /* Filter */
 static int pokey_frq; /* Hz - for easier resampling */
 static int filter_size;
+#ifdef LOW_MEMORY
+/* Only the single precision filter is kept: filter_data is then only
+   allocated while a filter is designed */
+#ifdef STAT_RESAMPLING
+#error "STAT_RESAMPLING needs the double precision filter, which LOW_MEMORY omits"
+#endif
+#else
 static double filter_data[SND_FILTER_SIZE];
+#endif
+/* single precision copy of filter_data, used by read_resam_all(). The
+   extra entry is zero, for the interpolation of the oldest queued event */
+static float filter_data_f[SND_FILTER_SIZE + 1];
 static int audible_frq;
 
 static const int pokey_frq_ideal =  1789790; /* Hz - True */
@@ -78,11 +91,32 @@ static const int pokey_frq_ideal =  1789790; /* Hz - True */
 /* Flags and quality */
 static int snd_quality = 0;
 
-/* Poly tables */
+/* State of the dithering noise generator (see dither_noise()), restarted
+   by MZPOKEYSND_Init() so that replaying the same writes gives the same
+   output */
+static uint32_t dither_seed = 1;
+
+/* Poly tables. Only bit 0 of each entry is used, so the LOW_MEMORY
+   profile stores the sequences as packed bits, read a word at a time
+   (poly17tbl is then 16 KB rather than 128 KB) */
+#ifdef LOW_MEMORY
+#define POLY_WORDS(size) (((size) + 31) >> 5)
+#define POLY_BIT(tbl, pos) (((tbl)[(pos) >> 5] >> ((pos) & 31)) & 1)
+#define POLY_SET(tbl, pos, val) \
+    ((tbl)[(pos) >> 5] = ((tbl)[(pos) >> 5] & ~((uint32_t)1 << ((pos) & 31))) \
+                         | ((uint32_t)((val) & 1) << ((pos) & 31)))
+static uint32_t poly4tbl[POLY_WORDS(15)];
+static uint32_t poly5tbl[POLY_WORDS(31)];
+static uint32_t poly17tbl[POLY_WORDS(131071)];
+static uint32_t poly9tbl[POLY_WORDS(511)];
+#else
+#define POLY_BIT(tbl, pos) ((tbl)[pos] & 1)
+#define POLY_SET(tbl, pos, val) ((tbl)[pos] = (val))
 static int poly4tbl[15];
 static int poly5tbl[31];
 static unsigned char poly17tbl[131071];
 static int poly9tbl[511];
+#endif
 
 
 struct stPokeyState;
@@ -116,6 +150,7 @@ typedef struct stPokeyState
     qev_t ovola;
     int qet[1322]; /* maximal length of filter */
     qev_t qev[1322];
+    float qed[1322]; /* volume change made by each event */
     int qebeg;
     int qeend;
 
@@ -407,7 +442,13 @@ static void ResetPokeyState(PokeyState* ps)
 }
 
 
-static double read_resam_all(PokeyState* ps)
+#ifdef STAT_RESAMPLING
+double MZPOKEYSND_resam_signal_energy = 0.0;
+double MZPOKEYSND_resam_error_energy = 0.0;
+double MZPOKEYSND_resam_max_error = 0.0;
+
+/* Reference double precision implementation of read_resam_all() */
+static double read_resam_all_double(PokeyState* ps)
 {
     int i = ps->qebeg;
     qev_t avol,bvol;
@@ -446,64 +487,148 @@ static double read_resam_all(PokeyState* ps)
     sum += avol*filter_data[0];
     return sum;
 }
+#endif /* STAT_RESAMPLING */
 
-#ifdef SYNCHRONIZED_SOUND
-/* linear interpolation of filter data */
-static double interp_filter_data(int pos, double frac)
+/* Filters the queued volume changes beg..end-1 (not wrapping). Volume
+   changes are stored as deltas, so the products are independent of each
+   other: four partial sums are kept, so they can be pipelined/vectorized */
+static float resam_changes(const PokeyState* ps, int beg, int end)
 {
-	if (pos+1 >= filter_size) {
-		return 0.0;
-	}
-	return (frac)*filter_data[pos+1]+(1-frac)*(filter_data[pos]-filter_data[filter_size-1]);
+    const float *qed = ps->qed + beg;
+    const int *qet = ps->qet + beg;
+    int curtick = ps->curtick;
+    int n = end - beg;
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+    int i;
+
+    for (i = 0; i + 3 < n; i += 4)
+    {
+        sum0 += qed[i] * filter_data_f[curtick - qet[i]];
+        sum1 += qed[i + 1] * filter_data_f[curtick - qet[i + 1]];
+        sum2 += qed[i + 2] * filter_data_f[curtick - qet[i + 2]];
+        sum3 += qed[i + 3] * filter_data_f[curtick - qet[i + 3]];
+    }
+    for (; i < n; i++)
+        sum0 += qed[i] * filter_data_f[curtick - qet[i]];
+
+    return (sum0 + sum1) + (sum2 + sum3);
 }
 
-/* returns the filtered output sample value using an interpolated filter */
-/* frac is the fractional distance of the output sample point between
- * input sample values */
-static double interp_read_resam_all(PokeyState* ps, double frac)
+/* Single precision filtering of the change queue. Compared to the double
+   precision version (see STAT_RESAMPLING), the error stays below 0.05 LSB
+   of 16-bit output, with an SNR above 120 dB */
+static double read_resam_all(PokeyState* ps)
 {
-    int i = ps->qebeg;
-    qev_t avol,bvol;
-    double sum;
+    float sum;
 
-    if (ps->qebeg == ps->qeend)
+    if(ps->qebeg == ps->qeend)
     {
-        return ps->ovola * interp_filter_data(0,frac); /* if no events in the queue */
+        return ps->ovola * filter_data_f[0]; /* if no events in the queue */
     }
 
-    avol = ps->ovola;
-    sum = 0;
+    /* Split the queue once at the wrap-around */
+    if(ps->qeend < ps->qebeg)
+    {
+        sum = resam_changes(ps, ps->qebeg, filter_size);
+        sum += resam_changes(ps, 0, ps->qeend);
+    }
+    else
+        sum = resam_changes(ps, ps->qebeg, ps->qeend);
 
-    /* Separate two loop cases, for wrap-around and without */
-    if (ps->qeend < ps->qebeg) /* With wrap */
+    /* current volume */
+    sum += ps->qev[(ps->qeend > 0 ? ps->qeend : filter_size) - 1] * filter_data_f[0];
+
+#ifdef STAT_RESAMPLING
     {
-        while (i < filter_size)
-        {
-            bvol = ps->qev[i];
-            sum += (avol-bvol)*interp_filter_data(ps->curtick - ps->qet[i],frac);
-            avol = bvol;
-            ++i;
-        }
-        i = 0;
+        double ref = read_resam_all_double(ps);
+        double error = fabs((double)sum - ref);
+        MZPOKEYSND_resam_signal_energy += ref * ref;
+        MZPOKEYSND_resam_error_energy += error * error;
+        if (error > MZPOKEYSND_resam_max_error)
+            MZPOKEYSND_resam_max_error = error;
     }
+#endif /* STAT_RESAMPLING */
 
-    /* without wrap */
-    while (i < ps->qeend)
+    return sum;
+}
+
+#ifdef SYNCHRONIZED_SOUND
+/* Filters the queued volume changes beg..end-1 (not wrapping) with the
+   filter linearly interpolated at frac. The sum of the changes is added
+   to *delta, the caller corrects for the filter's end value with it */
+static float interp_resam_changes(const PokeyState* ps, int beg, int end,
+                                  float frac, float *delta)
+{
+    const float *qed = ps->qed + beg;
+    const int *qet = ps->qet + beg;
+    int curtick = ps->curtick;
+    int n = end - beg;
+    float frac0 = 1.0f - frac;
+    float sum0 = 0.0f, sum1 = 0.0f, dsum = 0.0f;
+    int i;
+
+    for (i = 0; i + 1 < n; i += 2)
     {
-        bvol = ps->qev[i];
-        sum += (avol-bvol)*interp_filter_data(ps->curtick - ps->qet[i],frac);
-        avol = bvol;
-        ++i;
+        const float *f0 = filter_data_f + (curtick - qet[i]);
+        const float *f1 = filter_data_f + (curtick - qet[i + 1]);
+        sum0 += qed[i] * (frac * f0[1] + frac0 * f0[0]);
+        sum1 += qed[i + 1] * (frac * f1[1] + frac0 * f1[0]);
+        dsum += qed[i] + qed[i + 1];
+    }
+    if (i < n)
+    {
+        const float *f0 = filter_data_f + (curtick - qet[i]);
+        sum0 += qed[i] * (frac * f0[1] + frac0 * f0[0]);
+        dsum += qed[i];
     }
 
-    sum += avol*interp_filter_data(0,frac);
+    *delta += dsum;
+    return sum0 + sum1;
+}
 
-    return sum;
+/* returns the filtered output sample value using an interpolated filter */
+/* frac is the fractional distance of the output sample point between
+ * input sample values. Single precision, as read_resam_all() */
+static double interp_read_resam_all(PokeyState* ps, double frac)
+{
+    float fracf = (float)frac;
+    float frac0 = 1.0f - fracf;
+    float end = filter_data_f[filter_size - 1];
+    float sum, delta = 0.0f;
+
+    if (ps->qebeg == ps->qeend)
+    {
+        /* if no events in the queue */
+        return ps->ovola * (fracf * filter_data_f[1]
+                            + frac0 * (filter_data_f[0] - end));
+    }
+
+    /* Split the queue once at the wrap-around */
+    if (ps->qeend < ps->qebeg)
+    {
+        sum = interp_resam_changes(ps, ps->qebeg, filter_size, fracf, &delta);
+        sum += interp_resam_changes(ps, 0, ps->qeend, fracf, &delta);
+    }
+    else
+        sum = interp_resam_changes(ps, ps->qebeg, ps->qeend, fracf, &delta);
+
+    /* current volume */
+    delta += ps->qev[(ps->qeend > 0 ? ps->qeend : filter_size) - 1];
+    sum += ps->qev[(ps->qeend > 0 ? ps->qeend : filter_size) - 1]
+           * (fracf * filter_data_f[1] + frac0 * filter_data_f[0]);
+
+    return sum - frac0 * end * delta;
 }
 #endif  /* SYNCHRONIZED_SOUND */
 
 static void add_change(PokeyState* ps, qev_t a)
 {
+    /* the volume before this change is that of the previous event, or
+       ovola (the last event removed from the queue) if it is empty */
+    qev_t prev = (ps->qebeg == ps->qeend) ? ps->ovola :
+        ps->qev[(ps->qeend > 0 ? ps->qeend : filter_size) - 1];
+
+    ps->qed[ps->qeend] = (float)(prev - a);
     ps->qev[ps->qeend] = a;
     ps->qet[ps->qeend] = ps->curtick; /*0;*/
     ++ps->qeend;
@@ -575,7 +700,7 @@ static void build_poly4(void)
 
     for(i=0; i<15; i++)
     {
-        poly4tbl[i] = ~poly4;
+        POLY_SET(poly4tbl, i, ~poly4);
         c = ((poly4>>2)&1) ^ ((poly4>>3)&1);
         poly4 = ((poly4<<1)&15) + c;
     }
@@ -588,7 +713,7 @@ static void build_poly5(void)
 	unsigned char poly5 = 1;
 
 	for(i = 0; i < 31; i++) {
-		poly5tbl[i] = ~poly5; /* Inversion! Attention! */
+		POLY_SET(poly5tbl, i, ~poly5); /* Inversion! Attention! */
 		c = ((poly5 >> 2) ^ (poly5 >> 4)) & 1;
 		poly5 = ((poly5 << 1) & 31) + c;
 	}
@@ -601,7 +726,7 @@ static void build_poly17(void)
 	unsigned int poly17 = 1;
 
 	for(i = 0; i < 131071; i++) {
-		poly17tbl[i] = (unsigned char) poly17;
+		POLY_SET(poly17tbl, i, (unsigned char) poly17);
 		c = ((poly17 >> 11) ^ (poly17 >> 16)) & 1;
 		poly17 = ((poly17 << 1) & 131071) + c;
 	}
@@ -614,7 +739,7 @@ static void build_poly9(void)
 	unsigned int poly9 = 1;
 
 	for(i = 0; i < 511; i++) {
-		poly9tbl[i] = (unsigned char) poly9;
+		POLY_SET(poly9tbl, i, (unsigned char) poly9);
 		c = ((poly9 >> 3) ^ (poly9 >> 8)) & 1;
 		poly9 = ((poly9 << 1) & 511) + c;
 	}
@@ -1011,12 +1136,12 @@ static void advance_ticks(PokeyState* ps, int ticks)
 
         if(need)
         {
-            p5v = poly5tbl[ps->poly5pos] & 1;
-            p4v = poly4tbl[ps->poly4pos] & 1;
+            p5v = POLY_BIT(poly5tbl, ps->poly5pos);
+            p4v = POLY_BIT(poly4tbl, ps->poly4pos);
             if(ps->selpoly9)
-                p917v = poly9tbl[ps->poly9pos] & 1;
+                p917v = POLY_BIT(poly9tbl, ps->poly9pos);
             else
-                p917v = poly17tbl[ps->poly17pos] & 1;
+                p917v = POLY_BIT(poly17tbl, ps->poly17pos);
 
 #ifdef NONLINEAR_MIXING
             if(ta == tbe0)
@@ -1142,8 +1267,11 @@ static double generate_sample(PokeyState* ps)
  filter table generator by Krzysztof Nikiel
  ******************************************/
 
-static int remez_filter_table(double resamp_rate, /* output_rate/input_rate */
-                              double *cutoff, int quality)
+/* Designs the resampling filter for the given ratio into 'data'
+   (as a reversed cumulative sum) and returns its size, or 0 if it
+   does not fit in SND_FILTER_SIZE entries */
+static int design_filter(double resamp_rate, /* output_rate/input_rate */
+                         int quality, double *data)
 {
   int i;
   static const int orders[] = {600, 800, 1000, 1200};
@@ -1164,8 +1292,7 @@ static int remez_filter_table(double resamp_rate, /* output_rate/input_rate */
   double weights[2], desired[2], bands[4];
   static const int interlevel = 5;
   double step = 1.0 / interlevel;
-
-  *cutoff = 0.95 * 0.5 * resamp_rate;
+  double cutoff = 0.95 * 0.5 * resamp_rate;
 
   if (quality >= (int) (sizeof(passtab) / sizeof(passtab[0])))
     quality = (int) (sizeof(passtab) / sizeof(passtab[0])) - 1;
@@ -1174,7 +1301,7 @@ static int remez_filter_table(double resamp_rate, /* output_rate/input_rate */
   {
     for (order = 0; order < (int) (sizeof(orders)/sizeof(orders[0])); order++)
     {
-      if ((*cutoff - paramtab[ripple].twidth[order])
+      if ((cutoff - paramtab[ripple].twidth[order])
 	  > passtab[quality] * 0.5 * resamp_rate)
 	/* transition width OK */
 	goto found;
@@ -1187,15 +1314,6 @@ static int remez_filter_table(double resamp_rate, /* output_rate/input_rate */
 
 found:
 
-#if 0
-  printf("order: %d, cutoff: %g\tstopband:%d\ttranswidth:%f\n",
-         orders[order],
-	 1789790 * *cutoff,
-	 paramtab[ripple].stop,
-	 1789790 * paramtab[ripple].twidth[order]);
-  exit(1);
-#endif
-
   size = orders[order] + 1;
 
   if (size > SND_FILTER_SIZE) /* static table too short */
@@ -1208,42 +1326,163 @@ found:
   weights[1] = paramtab[ripple].weight;
 
   bands[0] = 0;
-  bands[2] = *cutoff;
+  bands[2] = cutoff;
   bands[1] = bands[2] - paramtab[ripple].twidth[order];
   bands[3] = 0.5;
 
   bands[1] *= (double)interlevel;
   bands[2] *= (double)interlevel;
-  REMEZ_CreateFilter(filter_data, (size / interlevel) + 1, 2, bands, desired, weights, REMEZ_BANDPASS);
+  REMEZ_CreateFilter(data, (size / interlevel) + 1, 2, bands, desired, weights, REMEZ_BANDPASS);
   for (i = size - interlevel; i >= 0; i -= interlevel)
   {
     int s;
-    double h1 = filter_data[i/interlevel];
-    double h2 = filter_data[i/interlevel+1];
+    double h1 = data[i/interlevel];
+    double h2 = data[i/interlevel+1];
 
     for (s = 0; s < interlevel; s++)
     {
       double d = (double)s * step;
-      filter_data[i+s] = (h1*(1.0 - d) + h2 * d) * step;
+      data[i+s] = (h1*(1.0 - d) + h2 * d) * step;
     }
   }
 
   /* compute reversed cumulative sum table */
   for (i = size - 2; i >= 0; i--)
-    filter_data[i] += filter_data[i + 1];
+    data[i] += data[i + 1];
 
-#if 0
-  for (i = 0; i < size; i++)
-    printf("%.15f,\n", filter_data[i]);
-  fflush(stdout);
-  exit(1);
+  return size;
+}
+
+/* Filters designed at runtime, for rates without a precomputed table.
+   Re-initialising the sound (e.g. when switching between two rates)
+   then only runs the remez design once per rate */
+#define FILTER_CACHE_ENTRIES 2
+static struct {
+  int playback_freq;
+  int pokey_frq;
+  int quality;
+  int size;
+  snd_filter_t data[SND_FILTER_SIZE];
+} filter_cache[FILTER_CACHE_ENTRIES];
+static int filter_cache_next = 0;
+
+/* Fills filter_data (except with LOW_MEMORY) and filter_data_f with the
+   filter for resampling from pokey_frq to playback_freq, taken from the
+   precomputed tables in mzpokeysnd_filters.h or the runtime cache where
+   possible */
+static int remez_filter_table(int playback_freq, double *cutoff, int quality)
+{
+  double resamp_rate = (double)playback_freq / pokey_frq;
+  const snd_filter_t *data = NULL;
+  int i;
+  int size = 0;
+
+  *cutoff = 0.95 * 0.5 * resamp_rate;
+
+  for (i = 0; i < (int) (sizeof(precomputed_filters) / sizeof(precomputed_filters[0])); i++)
+  {
+    if (precomputed_filters[i].playback_freq == playback_freq
+        && precomputed_filters[i].pokey_frq == pokey_frq
+        && precomputed_filters[i].quality == quality)
+    {
+      size = precomputed_filters[i].size;
+      data = precomputed_filters[i].data;
+      break;
+    }
+  }
+
+  for (i = 0; size == 0 && i < FILTER_CACHE_ENTRIES; i++)
+  {
+    if (filter_cache[i].size > 0
+        && filter_cache[i].playback_freq == playback_freq
+        && filter_cache[i].pokey_frq == pokey_frq
+        && filter_cache[i].quality == quality)
+    {
+      size = filter_cache[i].size;
+      data = filter_cache[i].data;
+    }
+  }
+
+  if (size == 0)
+  {
+#ifdef LOW_MEMORY
+    double *filter_data = (double *) malloc(SND_FILTER_SIZE * sizeof(double));
+    size = filter_data != NULL ? design_filter(resamp_rate, quality, filter_data) : 0;
+#else
+    size = design_filter(resamp_rate, quality, filter_data);
 #endif
+    if (size > 0)
+    {
+      filter_cache[filter_cache_next].playback_freq = playback_freq;
+      filter_cache[filter_cache_next].pokey_frq = pokey_frq;
+      filter_cache[filter_cache_next].quality = quality;
+      filter_cache[filter_cache_next].size = size;
+      for (i = 0; i < size; i++)
+        filter_cache[filter_cache_next].data[i] = (snd_filter_t)filter_data[i];
+      data = filter_cache[filter_cache_next].data;
+      filter_cache_next = (filter_cache_next + 1) % FILTER_CACHE_ENTRIES;
+    }
+#ifdef LOW_MEMORY
+    free(filter_data);
+#endif
+  }
+
+#ifndef LOW_MEMORY
+  if (size > 0)
+    memcpy(filter_data, data, size * sizeof(double));
+#endif
+  for (i = 0; i < size; i++)
+    filter_data_f[i] = (float)data[i];
+  filter_data_f[size] = 0.0f;
 
   return size;
 }
 
+#ifdef MZPOKEYSND_DUMP_FILTERS
+/* Writes mzpokeysnd_filters.h, the precomputed filters for the
+   playback rates offered by the core */
+void MZPOKEYSND_DumpFilters(FILE *f)
+{
+  static const int rates[] = {22050, 31440, 44100, 48000};
+  static double data[SND_FILTER_SIZE];
+  int r, i;
+
+  fprintf(f, "/* Generated by MZPOKEYSND_DumpFilters() - do not edit.\n");
+  fprintf(f, "   Precomputed resampling filters of design_filter() at quality 0.\n");
+  fprintf(f, "   To regenerate, build mzpokeysnd.c with MZPOKEYSND_DUMP_FILTERS\n");
+  fprintf(f, "   defined and call MZPOKEYSND_DumpFilters() from a small driver. */\n\n");
+  fprintf(f, "#ifndef MZPOKEYSND_FILTERS_H_\n#define MZPOKEYSND_FILTERS_H_\n\n");
+  fprintf(f, "/* read_resam_all() only uses the single precision copy of a filter,\n");
+  fprintf(f, "   so the LOW_MEMORY profile stores the tables as float */\n");
+  fprintf(f, "#ifdef LOW_MEMORY\ntypedef float snd_filter_t;\n#else\ntypedef double snd_filter_t;\n#endif\n");
+
+  for (r = 0; r < (int) (sizeof(rates) / sizeof(rates[0])); r++)
+  {
+    int frq = (int)(((double)pokey_frq_ideal/rates[r]) + 0.5) * rates[r];
+    int size = design_filter((double)rates[r]/frq, 0, data);
+
+    fprintf(f, "\nstatic const snd_filter_t filter_%d_q0[%d] = {\n", rates[r], size);
+    for (i = 0; i < size; i++)
+      fprintf(f, "%.17g,%s", data[i], (i % 4 == 3 || i == size - 1) ? "\n" : " ");
+    fprintf(f, "};\n");
+  }
+
+  fprintf(f, "\nstatic const struct {\n  int playback_freq;\n  int pokey_frq;\n"
+             "  int quality;\n  int size;\n  const snd_filter_t *data;\n} precomputed_filters[] =\n{\n");
+  for (r = 0; r < (int) (sizeof(rates) / sizeof(rates[0])); r++)
+  {
+    int frq = (int)(((double)pokey_frq_ideal/rates[r]) + 0.5) * rates[r];
+
+    fprintf(f, "  {%d, %d, 0, (int) (sizeof(filter_%d_q0) / sizeof(snd_filter_t)), filter_%d_q0},\n",
+            rates[r], frq, rates[r], rates[r]);
+  }
+  fprintf(f, "};\n\n#endif /* MZPOKEYSND_FILTERS_H_ */\n");
+}
+#endif /* MZPOKEYSND_DUMP_FILTERS */
+
 static void mzpokeysnd_process_8(void* sndbuffer, int sndn);
 static void mzpokeysnd_process_16(void* sndbuffer, int sndn);
+static void mzpokeysnd_process_16_stereo(void* sndbuffer, int sndn);
 static void Update_pokey_sound_mz(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain);
 #ifdef SERIO_SOUND
 static void Update_serio_sound_mz(int out, UBYTE data);
@@ -1275,7 +1514,7 @@ static void generate_sync(unsigned int num_ticks);
 
 static void init_syncsound(void)
 {
-    double samples_per_frame = (double)POKEYSND_playback_freq/(tv_mode == TV_PAL ? FPS_PAL : FPS_NTSC);
+    double samples_per_frame = (double)POKEYSND_playback_freq/POKEYSND_frame_rate;
     unsigned int ticks_per_frame = tv_mode*114;
     ticks_per_sample = (double)ticks_per_frame / samples_per_frame;
     samp_pos = 0.0;
@@ -1290,6 +1529,7 @@ int MZPOKEYSND_Init(uint32_t freq17, int playback_freq, UBYTE num_pokeys,
     double cutoff;
 
     snd_quality = quality;
+    dither_seed = 1;
 
     POKEYSND_Update_ptr = Update_pokey_sound_mz;
 #ifdef SERIO_SOUND
@@ -1306,12 +1546,14 @@ int MZPOKEYSND_Init(uint32_t freq17, int playback_freq, UBYTE num_pokeys,
 	POKEYSND_samp_freq=playback_freq;
 #endif  /* VOL_ONLY_SOUND */
 
-	POKEYSND_Process_ptr = (flags & POKEYSND_BIT16) ? mzpokeysnd_process_16 : mzpokeysnd_process_8;
+	if (flags & POKEYSND_BIT16)
+		POKEYSND_Process_ptr = (flags & POKEYSND_STEREO) ? mzpokeysnd_process_16_stereo : mzpokeysnd_process_16;
+	else
+		POKEYSND_Process_ptr = mzpokeysnd_process_8;
 
     pokey_frq = (int)(((double)pokey_frq_ideal/POKEYSND_playback_freq) + 0.5)
           * POKEYSND_playback_freq;
-	filter_size = remez_filter_table((double)POKEYSND_playback_freq/pokey_frq,
-					 &cutoff, quality);
+	filter_size = remez_filter_table(POKEYSND_playback_freq, &cutoff, quality);
 	audible_frq = (int ) (cutoff * pokey_frq);
 
     build_poly4();
@@ -2196,6 +2438,45 @@ static void Update_pokey_sound_mz(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain)
 
 #define MAX_SAMPLE 152
 
+/* Scale factors from generate_sample() units to output units */
+#define SCALE_8 (255.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95)
+#define SCALE_16 (65535.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95)
+
+/* floor() for arguments greater than -65536, without the libm call */
+#define FAST_FLOOR(x) ((int)((x) + 65536.0) - 65536)
+
+/* Dithering noise in [-0.25, 0.25), from a 32-bit LCG (Numerical Recipes
+   constants). The low bits of the LCG are poor, so only the top 24 are
+   used. This is plenty for dithering, and cheaper than a rand() call */
+static double dither_noise(void)
+{
+    dither_seed = dither_seed * 1664525U + 1013904223U;
+    return (double)(dither_seed >> 8) * (0.5 / 16777216.0) - 0.25;
+}
+
+#ifdef VOL_ONLY_SOUND
+/* Takes the volume-only sample for the next output sample */
+static void advance_vol_only(void)
+{
+    if( POKEYSND_sampbuf_rptr!=POKEYSND_sampbuf_ptr )
+        { int l;
+        if( POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]>0 )
+            POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]-=1280;
+        while(  (l=POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr])<=0 )
+            {	POKEYSND_sampout=POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
+                    POKEYSND_sampbuf_rptr++;
+                    if( POKEYSND_sampbuf_rptr>=POKEYSND_SAMPBUF_MAX )
+                            POKEYSND_sampbuf_rptr=0;
+                    if( POKEYSND_sampbuf_rptr!=POKEYSND_sampbuf_ptr )
+                        {
+                        POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]+=l;
+                        }
+                    else	break;
+            }
+        }
+}
+#endif
+
 static void mzpokeysnd_process_8(void* sndbuffer, int sndn)
 {
     int i;
@@ -2210,35 +2491,17 @@ static void mzpokeysnd_process_8(void* sndbuffer, int sndn)
     while(nsam >= (int) num_cur_pokeys)
     {
 #ifdef VOL_ONLY_SOUND
-        if( POKEYSND_sampbuf_rptr!=POKEYSND_sampbuf_ptr )
-            { int l;
-            if( POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]>0 )
-                POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]-=1280;
-            while(  (l=POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr])<=0 )
-                {	POKEYSND_sampout=POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
-                        POKEYSND_sampbuf_rptr++;
-                        if( POKEYSND_sampbuf_rptr>=POKEYSND_SAMPBUF_MAX )
-                                POKEYSND_sampbuf_rptr=0;
-                        if( POKEYSND_sampbuf_rptr!=POKEYSND_sampbuf_ptr )
-                            {
-                            POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]+=l;
-                            }
-                        else	break;
-                }
-            }
-#endif
-
-#ifdef VOL_ONLY_SOUND
-        buffer[0] = (UBYTE)floor((generate_sample(pokey_states) + POKEYSND_sampout)
-         * (255.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95) + 128 + 0.5 + 0.5 * rand() / RAND_MAX - 0.25);
+        advance_vol_only();
+        buffer[0] = (UBYTE)FAST_FLOOR((generate_sample(pokey_states) + POKEYSND_sampout)
+         * SCALE_8 + 128 + 0.5 + dither_noise());
 #else
-        buffer[0] = (UBYTE)floor(generate_sample(pokey_states)
-         * (255.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95) + 128 + 0.5 + 0.5 * rand() / RAND_MAX - 0.25);
+        buffer[0] = (UBYTE)FAST_FLOOR(generate_sample(pokey_states)
+         * SCALE_8 + 128 + 0.5 + dither_noise());
 #endif
         for(i=1; i<num_cur_pokeys; i++)
         {
-            buffer[i] = (UBYTE)floor(generate_sample(pokey_states + i)
-             * (255.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95) + 128 + 0.5 + 0.5 * rand() / RAND_MAX - 0.25);
+            buffer[i] = (UBYTE)FAST_FLOOR(generate_sample(pokey_states + i)
+             * SCALE_8 + 128 + 0.5 + dither_noise());
         }
         buffer += num_cur_pokeys;
         nsam -= num_cur_pokeys;
@@ -2259,40 +2522,47 @@ static void mzpokeysnd_process_16(void* sndbuffer, int sndn)
     while(nsam >= (int) num_cur_pokeys)
     {
 #ifdef VOL_ONLY_SOUND
-        if( POKEYSND_sampbuf_rptr!=POKEYSND_sampbuf_ptr )
-            { int l;
-            if( POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]>0 )
-                POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]-=1280;
-            while(  (l=POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr])<=0 )
-                {	POKEYSND_sampout=POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
-                        POKEYSND_sampbuf_rptr++;
-                        if( POKEYSND_sampbuf_rptr>=POKEYSND_SAMPBUF_MAX )
-                                POKEYSND_sampbuf_rptr=0;
-                        if( POKEYSND_sampbuf_rptr!=POKEYSND_sampbuf_ptr )
-                            {
-                            POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]+=l;
-                            }
-                        else	break;
-                }
-            }
-#endif
-#ifdef VOL_ONLY_SOUND
-            buffer[0] = (SWORD)floor((generate_sample(pokey_states) + POKEYSND_sampout)
-             * (65535.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95) + 0.5 + 0.5 * rand() / RAND_MAX - 0.25);
+        advance_vol_only();
+        buffer[0] = (SWORD)FAST_FLOOR((generate_sample(pokey_states) + POKEYSND_sampout)
+         * SCALE_16 + 0.5 + dither_noise());
 #else
-            buffer[0] = (SWORD)floor(generate_sample(pokey_states)
-             * (65535.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95) + 0.5 + 0.5 * rand() / RAND_MAX - 0.25);
+        buffer[0] = (SWORD)FAST_FLOOR(generate_sample(pokey_states)
+         * SCALE_16 + 0.5 + dither_noise());
 #endif
         for(i=1; i<num_cur_pokeys; i++)
         {
-            buffer[i] = (SWORD)floor(generate_sample(pokey_states + i)
-             * (65535.0 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95) + 0.5 + 0.5 * rand() / RAND_MAX - 0.25);
+            buffer[i] = (SWORD)FAST_FLOOR(generate_sample(pokey_states + i)
+             * SCALE_16 + 0.5 + dither_noise());
         }
         buffer += num_cur_pokeys;
         nsam -= num_cur_pokeys;
     }
 }
 
+/* single POKEY, written to both channels of a 16-bit stereo buffer */
+static void mzpokeysnd_process_16_stereo(void* sndbuffer, int sndn)
+{
+    int nsam;
+    SWORD *buffer = (SWORD *) sndbuffer;
+
+    if(num_cur_pokeys<1)
+        return; /* module was not initialized */
+
+    for(nsam = 0; nsam < sndn; nsam++)
+    {
+        int smp;
+#ifdef VOL_ONLY_SOUND
+        advance_vol_only();
+        smp = FAST_FLOOR((generate_sample(pokey_states) + POKEYSND_sampout)
+         * SCALE_16 + 0.5 + dither_noise());
+#else
+        smp = FAST_FLOOR(generate_sample(pokey_states)
+         * SCALE_16 + 0.5 + dither_noise());
+#endif
+        POKEYSND_PUT_STEREO16(buffer, smp);
+    }
+}
+
 #ifdef SYNCHRONIZED_SOUND
 static void generate_sync(unsigned int num_ticks)
 {
@@ -2321,18 +2591,26 @@ static void generate_sync(unsigned int num_ticks)
 			/* advance pokey to the new position and produce a sample */
 			advance_ticks(pokey_states + i, ticks);
 			if (POKEYSND_snd_flags & POKEYSND_BIT16) {
-				*((SWORD *)buffer) = (SWORD)floor(
+				int smp = FAST_FLOOR(
 					interp_read_resam_all(pokey_states + i, samp_pos)
 					* (volume.s16 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95)
-					+ 0.5 + 0.5 * rand() / RAND_MAX - 0.25
+					+ 0.5 + dither_noise()
 				);
-				buffer += 2;
+				if (POKEYSND_snd_flags & POKEYSND_STEREO) {
+					SWORD *stereo = (SWORD *)buffer;
+					POKEYSND_PUT_STEREO16(stereo, smp);
+					buffer = (UBYTE *)stereo;
+				}
+				else {
+					*((SWORD *)buffer) = (SWORD)smp;
+					buffer += 2;
+				}
 			}
 			else
-				*buffer++ = (UBYTE)floor(
+				*buffer++ = (UBYTE)FAST_FLOOR(
 					interp_read_resam_all(pokey_states + i, samp_pos)
 					* (volume.s8 / 2 / MAX_SAMPLE / 4 * M_PI * 0.95)
-					+ 128 + 0.5 + 0.5 * rand() / RAND_MAX - 0.25
+					+ 128 + 0.5 + dither_noise()
 				);
 		}
 	}
@@ -10,4 +10,20 @@ int MZPOKEYSND_Init(uint32_t freq17,
                         int quality
                        );
 
+/* STAT_RESAMPLING is solely for benchmarking purposes: the single precision
+   resampler output is compared against the double precision reference.
+   SNR (dB) = 10 * log10(signal_energy / error_energy). Values are in
+   output units before scaling (one 16-bit LSB is about 0.0061). */
+#ifdef MZPOKEYSND_DUMP_FILTERS
+#include <stdio.h>
+/* Writes the precomputed filter tables (mzpokeysnd_filters.h) to f */
+void MZPOKEYSND_DumpFilters(FILE *f);
+#endif
+
+#ifdef STAT_RESAMPLING
+extern double MZPOKEYSND_resam_signal_energy;
+extern double MZPOKEYSND_resam_error_energy;
+extern double MZPOKEYSND_resam_max_error;
+#endif
+
 #endif /* MZPOKEYSND_H_ */
@@ -0,0 +1,797 @@
+/* Generated by MZPOKEYSND_DumpFilters() - do not edit.
+   Precomputed resampling filters of design_filter() at quality 0.
+   To regenerate, build mzpokeysnd.c with MZPOKEYSND_DUMP_FILTERS
+   defined and call MZPOKEYSND_DumpFilters() from a small driver. */
+
+#ifndef MZPOKEYSND_FILTERS_H_
+#define MZPOKEYSND_FILTERS_H_
+
+/* read_resam_all() only uses the single precision copy of a filter,
+   so the LOW_MEMORY profile stores the tables as float */
+#ifdef LOW_MEMORY
+typedef float snd_filter_t;
+#else
+typedef double snd_filter_t;
+#endif
+
+static const snd_filter_t filter_22050_q0[1001] = {
+1.0315901559563998, 1.0318247951425907, 1.0318717229798289, 1.0319146508511661,
+1.0319535787566025, 1.0319885066961381, 1.0320194346697726, 1.0320463626775065,
+1.0320747213874903, 1.0321045107997242, 1.0321357309142081, 1.0321683817309419,
+1.032202463249926, 1.0322381326923857, 1.032275390058321, 1.0323142353477319,
+1.0323546685606184, 1.0323966896969805, 1.032440437037458, 1.032485910582051,
+1.0325331103307596, 1.0325820362835836, 1.032632688440523, 1.0326851854668386,
+1.0327395273625304, 1.0327957141275983, 1.0328537457620426, 1.032913622265863,
+1.0329754307159962, 1.033039171112442, 1.0331048434552006, 1.0331724477442719,
+1.0332419839796558, 1.0333135081744766, 1.0333870203287341, 1.0334625204424284,
+1.0335400085155595, 1.0336194845481272, 1.0337009607542351, 1.0337844371338831,
+1.0338699136870713, 1.0339573904137995, 1.0340468673140679, 1.034138311745703,
+1.0342317237087051, 1.0343271032030741, 1.03442445022881, 1.0345237647859127,
+1.0346249562572445, 1.0347280246428054, 1.0348329699425955, 1.0349397921566148,
+1.035048491284863, 1.0351589180916632, 1.0352710725770153, 1.0353849547409195,
+1.0355005645833757, 1.0356179021043839, 1.035736748809126, 1.0358571046976019,
+1.0359789697698116, 1.0361023440257553, 1.0362272274654327, 1.0363533356798056,
+1.0364806686688739, 1.0366092264326376, 1.0367390089710968, 1.0368700162842515,
+1.0370018907254728, 1.0371346322947606, 1.037268240992115, 1.0374027168175359,
+1.0375380597710235, 1.0376738448262122, 1.037810071983102, 1.0379467412416932,
+1.0380838526019855, 1.0382214060639792, 1.0383589004434697, 1.0384963357404573,
+1.0386337119549418, 1.0387710290869234, 1.0389082871364019, 1.0390449169920304,
+1.0391809186538088, 1.0393162921217372, 1.0394510373958155, 1.0395851544760437,
+1.0397180034055269, 1.039849584184265, 1.0399798968122578, 1.0401089412895055,
+1.0402367176160081, 1.0403625337763101, 1.0404863897704113, 1.0406082855983119,
+1.040728221260012, 1.0408461967555114, 1.0409614688929207, 1.0410740376722398,
+1.0411839030934689, 1.0412910651566079, 1.0413955238616568, 1.0414965000147347,
+1.0415939936158416, 1.0416880046649777, 1.0417785331621428, 1.041865579107337,
+1.041948323187085, 1.0420267654013866, 1.0421009057502419, 1.042170744233651,
+1.0422362808516137, 1.0422966875567115, 1.0423519643489443, 1.0424021112283122,
+1.0424471281948151, 1.0424870152484529, 1.0425209486572318, 1.0425489284211518,
+1.0425709545402126, 1.0425870270144146, 1.0425971458437575, 1.0426005206240241,
+1.0425971513552144, 1.0425870380373283, 1.042570180670366, 1.0425465792543274,
+1.042515450527111, 1.042476794488717, 1.0424306111391453, 1.0423769004783956,
+1.0423156625064682, 1.0422462024201355, 1.0421685202193973, 1.0420826159042536,
+1.0419884894747045, 1.0418861409307498, 1.0417749471259772, 1.0416549080603863,
+1.0415260237339772, 1.04138829414675, 1.0412417192987047, 1.0410857666856064,
+1.0409204363074551, 1.0407457281642509, 1.0405616422559938, 1.0403681785826837,
+1.0401649437750491, 1.0399519378330897, 1.0397291607568058, 1.0394966125461973,
+1.0392542932012641, 1.0390019362872327, 1.0387395418041032, 1.0384671097518756,
+1.0381846401305499, 1.0378921329401261, 1.0375894934889072, 1.0372767217768932,
+1.036953817804084, 1.0366207815704798, 1.0362776130760805, 1.0359243876766973,
+1.0355611053723301, 1.0351877661629794, 1.0348043700486447, 1.0344109170293261,
+1.0340076815879147, 1.0335946637244102, 1.033171863438813, 1.0327392807311229,
+1.0322969156013397, 1.0318452449613038, 1.0313842688110151, 1.0309139871504736,
+1.0304343999796792, 1.0299455072986321, 1.0294480060698434, 1.0289418962933132,
+1.0284271779690413, 1.0279038510970278, 1.0273719156772727, 1.0268322875272176,
+1.0262849666468623, 1.025729953036207, 1.0251672466952515, 1.0245968476239959,
+1.0240198970969685, 1.0234363951141692, 1.0228463416755977, 1.0222497367812544,
+1.0216465804311392, 1.0210382331548098, 1.0204246949522662, 1.0198059658235084,
+1.0191820457685363, 1.0185529347873501, 1.0179202112317338, 1.0172838751016875,
+1.0166439263972109, 1.0160003651183043, 1.0153531912649676, 1.0147041847261506,
+1.0140533455018534, 1.013400673592076, 1.0127461689968182, 1.0120898317160802,
+1.0114336290225086, 1.0107775609161034, 1.0101216273968647, 1.0094658284647926,
+1.0088101641198868, 1.0081567624787473, 1.0075056235413742, 1.0068567473077674,
+1.006210133777927, 1.0055657829518529, 1.0049259623700588, 1.0042906720325449,
+1.0036599119393108, 1.0030336820903569, 1.002411982485683, 1.0017971867221704,
+1.0011892947998193, 1.0005883067186299, 0.9999942224786017, 0.99940704207973508,
+0.99882920974893541, 0.9982607254862027, 0.99770158929153696, 0.99715180116493807,
+0.99661136110640614, 0.99608273985326612, 0.99556593740551791, 0.99506095376316162,
+0.99456778892619713, 0.99408644289462444, 0.99361937319748495, 0.99316657983477852,
+0.99272806280650516, 0.99230382211266488, 0.99189385775325767, 0.99150056683322851,
+0.99112394935257753, 0.9907640053113046, 0.99042073470940983, 0.99009413754689324,
+0.98978650025966908, 0.98949782284773735, 0.98922810531109817, 0.98897734764975143,
+0.98874554986369712, 0.98853483237659734, 0.98834519518845221, 0.98817663829926161,
+0.98802916170902555, 0.98790276541774402, 0.98779936072230956, 0.98771894762272205,
+0.9876615261189815, 0.98762709621108791, 0.98761565789904138, 0.98762885561407021,
+0.98766668935617452, 0.98772915912535431, 0.98781626492160945, 0.98792800674494008,
+0.98806570715876807, 0.98822936616309343, 0.98841898375791615, 0.98863455994323624,
+0.98887609471905369, 0.98914455196654105, 0.98943993168569833, 0.98976223387652551,
+0.9901114585390226, 0.99048760567318961, 0.99089122058235335, 0.99132230326651383,
+0.99178085372567104, 0.99226687195982499, 0.99278035796897557, 0.99332140818406911,
+0.99389002260510562, 0.99448620123208509, 0.99510994406500752, 0.99576125110387292,
+0.99643972525018332, 0.9971453665039387, 0.99787817486513897, 0.99863815033378422,
+0.99942529290987447, 1.0002386835144601, 1.001078322147541, 1.0019442088091173,
+1.0028363434991889, 1.003754726217756, 1.0046978913961833, 1.005665839034471,
+1.0066585691326191, 1.0076760816906274, 1.0087183767084962, 1.0097834253028679,
+1.0108712274737426, 1.0119817832211204, 1.0131150925450012, 1.0142711554453852,
+1.0154473714301462, 1.0166437404992845, 1.0178602626527999, 1.0190969378906927,
+1.0203537662129625, 1.0216275736457781, 1.0229183601891392, 1.0242261258430458,
+1.0255508706074981, 1.0268925944824958, 1.0282475600526071, 1.0296157673178317,
+1.0309972162781698, 1.0323919069336214, 1.0337998392841863, 1.0352167314360254,
+1.0366425833891391, 1.0380773951435269, 1.039521166699189, 1.0409738980561254,
+1.0424307907351158, 1.04389184473616, 1.0453570600592581, 1.0468264367044102,
+1.0482999746716162, 1.0497723966875008, 1.051243702752064, 1.0527138928653059,
+1.0541829670272265, 1.0556509252378257, 1.057112056693531, 1.0585663613943426,
+1.0600138393402601, 1.0614544905312837, 1.0628883149674135, 1.0643092263919141,
+1.0657172248047853, 1.0671123102060271, 1.0684944825956397, 1.069863741973623,
+1.0712136907011551, 1.0725443287782361, 1.073855656204866, 1.075147672981045,
+1.0764203791067728, 1.0776671364384285, 1.0788879449760118, 1.080082804719523,
+1.0812517156689618, 1.0823946778243285, 1.0835048922130328, 1.0845823588350747,
+1.0856270776904542, 1.0866390487791713, 1.0876182721012262, 1.0885578728616565,
+1.0894578510604622, 1.0903182066976433, 1.0911389397731999, 1.0919200502871318,
+1.0926546774590919, 1.0933428212890803, 1.093984481777097, 1.0945796589231418,
+1.0951283527272149, 1.0956238076253892, 1.0960660236176649, 1.0964550007040419,
+1.0967907388845202, 1.0970732381591, 1.0972959435293881, 1.0974588549953845,
+1.0975619725570893, 1.0976052962145024, 1.0975888259676239, 1.0975063045387505,
+1.0973577319278824, 1.0971431081350196, 1.096862433160162, 1.0965157070033098,
+1.0960970633590936, 1.0956065022275134, 1.0950440236085695, 1.0944096275022615,
+1.0937033139085897, 1.0929196977221363, 1.0920587789429013, 1.0911205575708849,
+1.0901050336060869, 1.0890122070485075, 1.0878372665740734, 1.0865802121827846,
+1.0852410438746409, 1.0838197616496426, 1.0823163655077894, 1.0807266953548322,
+1.079050751190771, 1.0772885330156059, 1.0754400408293368, 1.0735052746319635,
+1.071480806596893, 1.0693666367241252, 1.0671627650136604, 1.0648691914654982,
+1.0624859160796387, 1.0600103088099235, 1.0574423696563526, 1.054782098618926,
+1.0520294956976435, 1.0491845608925052, 1.0462455188681887, 1.043212369624694,
+1.0400851131620208, 1.0368637494801693, 1.0335482785791397, 1.0301378309141658,
+1.0266324064852477, 1.0230320052923854, 1.0193366273355788, 1.0155462726148281,
+1.0116610111024569, 1.0076808427984651, 1.0036057677028529, 0.9994357858156202,
+0.99517089713676699, 0.99081213802699908, 0.98635950848631648, 0.98181300851471909,
+0.977172638112207, 0.97243839727878023, 0.96761229725186293, 0.9626943380314551,
+0.95768451961755674, 0.95258284201016774, 0.94738930520928821, 0.94210689518599366,
+0.9367356119402841, 0.93127545547215951, 0.9257264257816199, 0.92008852286866527,
+0.91436569164826564, 0.90855793212042113, 0.90266524428513162, 0.89668762814239711,
+0.8906250836922176, 0.88448248573547827, 0.87825983427217902, 0.87195712930231994,
+0.86557437082590094, 0.85911155884292212, 0.85257445663625608, 0.84596306420590284,
+0.83927738155186227, 0.83251740867413448, 0.82568314557271949, 0.81878118791314358,
+0.81181153569540676, 0.80477418891950903, 0.79766914758545049, 0.79049641169323104,
+0.78326334456657165, 0.77596994620547233, 0.76861621660993307, 0.76120215577995387,
+0.75372776371553474, 0.74620109290981884, 0.73862214336280618, 0.73099091507449687,
+0.7233074080448908, 0.71557162227398796, 0.70779220962951461, 0.69996917011147075,
+0.69210250371985638, 0.68419221045467149, 0.67623829031591609, 0.66824990097821202,
+0.66022704244155916, 0.65216971470595764, 0.64407791777140744, 0.63595165163790845,
+0.62780047326988109, 0.61962438266732534, 0.6114233798302412, 0.60319746475862857,
+0.59494663745248755, 0.58668074603933174, 0.57839979051916113, 0.57010377089197573,
+0.56179268715777553, 0.55346653931656054, 0.54513535047205119, 0.53679912062424762,
+0.52845784977314969, 0.52011153791875753, 0.51176018506107102, 0.50341387320667885,
+0.49507260235558098, 0.4867363725077774, 0.47840518366326812, 0.47007903582205313,
+0.46176795208785293, 0.45347193246066753, 0.44519097694049692, 0.43692508552734111,
+0.42867425822120009, 0.42044834314958746, 0.41224734031250326, 0.40407124970994751,
+0.39592007134192014, 0.38779380520842122, 0.37970200827387102, 0.37164468053826949,
+0.36362182200161669, 0.35563343266391262, 0.34767951252515722, 0.33976921925997233,
+0.33190255286835796, 0.3240795133503141, 0.31630010070584075, 0.30856431493493791,
+0.30088080790533184, 0.29324957961702247, 0.28567063007000987, 0.27814395926429403,
+0.27066956719987489, 0.2632555063698957, 0.25590177677435644, 0.24860837841325711,
+0.2413753112865977, 0.23420257539437822, 0.22709753406031963, 0.22006018728442195,
+0.21309053506668515, 0.20618857740710925, 0.19935431430569422, 0.19259434142796644,
+0.1859086587739259, 0.1792972663435726, 0.17276016413690654, 0.16629735215392771,
+0.15991459367750877, 0.15361188870764966, 0.14738923724435044, 0.14124663928761105,
+0.13518409483743155, 0.12920647869469701, 0.12331379085940745, 0.11750603133156289,
+0.1117832001111633, 0.1061452971982087, 0.10059626750766912, 0.095136111039544571,
+0.089764827793835045, 0.084482417770540538, 0.079288880969661052, 0.074187203362272108,
+0.069177384948373694, 0.064259425727965822, 0.059433325701048492, 0.054699084867621699,
+0.050058714465109629, 0.045512214493512282, 0.041059584952829666, 0.036700825843061773,
+0.032435937164208603, 0.02826595527697592, 0.024190880181363731, 0.020210711877372028,
+0.016325450365000816, 0.012535095644250092, 0.0088397176874435678, 0.0052393164945812448,
+0.0017338920656631233, -0.0016765555993107977, -0.0049920265003405183, -0.0082133901821919396,
+-0.011340646644865062, -0.014373795888359884, -0.017312837912676408, -0.020157772717814632,
+-0.022910375639097098, -0.025570646676523812, -0.028138585830094768, -0.030614193099809967,
+-0.032997468485669409, -0.035291042033831606, -0.037494913744296553, -0.03960908361706425,
+-0.041633551652134698, -0.043568317849507897, -0.045416810035777078, -0.047179028210942248,
+-0.0488549723750034, -0.050444642527960541, -0.051948038669813665, -0.053369320894812049,
+-0.054708489202955693, -0.055965543594244604, -0.057140484068678776, -0.058233310626258208,
+-0.059248834591056128, -0.060187055963072535, -0.061047974742307422, -0.061831590928760796,
+-0.062537904522432658, -0.063172300628740602, -0.063734779247684628, -0.064225340379264736,
+-0.064643984023480927, -0.064990710180333186, -0.065271385155190695, -0.065486008948053454,
+-0.065634581558921462, -0.065717102987794707, -0.065733573234673201, -0.065690249577260051,
+-0.065587132015555272, -0.065424220549558848, -0.065201515179270794, -0.064919015904691096,
+-0.064583277724212726, -0.064194300637835697, -0.063752084645559995, -0.06325662974738562,
+-0.062707935943312587, -0.062112758797267763, -0.06147109830925114, -0.060782954479262727,
+-0.060048327307302522, -0.059267216793370527, -0.058446483717813968, -0.057586128080632848,
+-0.056686149881827165, -0.05574654912139692, -0.054767325799342112, -0.053755354710624925,
+-0.052710635855245359, -0.051633169233203408, -0.050522954844499077, -0.049379992689132367,
+-0.048211081739693434, -0.047016221996182279, -0.045795413458598909, -0.044548656126943316,
+-0.0432759500012155, -0.041983933225036615, -0.040672605798406661, -0.039341967721325637,
+-0.037992018993793543, -0.036622759615810373, -0.035240587226197891, -0.03384550182495609,
+-0.03243750341208497, -0.031016591987584538, -0.029582767551454787, -0.028142116360431142,
+-0.026694638414513597, -0.025240333713702153, -0.023779202257996814, -0.022311244047397576,
+-0.020842169885476988, -0.019371979772235048, -0.017900673707671757, -0.016428251691787115,
+-0.014954713724581122, -0.013485337079429045, -0.012020121756330883, -0.010559067755286637,
+-0.0091021750762963066, -0.0076494437193598917, -0.0062056721636977643, -0.0047708604093099245,
+-0.0033450084561963732, -0.0019281163043571097, -0.0005201839537921347, 0.00087450670165940565,
+0.0022559556619975111, 0.0036241629272221821, 0.0049791284973334177, 0.0063208523723312189,
+0.0076455971367834392, 0.0089533627906900788, 0.010244149334051138, 0.011517956766866616,
+0.012774785089136514, 0.014011460327029207, 0.015227982480544695, 0.01642435154968298,
+0.017600567534444059, 0.018756630434827934, 0.019889939758708772, 0.021000495506086573,
+0.022088297676961337, 0.023153346271333069, 0.024195641289201764, 0.025213153847210117,
+0.026205883945358128, 0.027173831583645801, 0.028116996762073132, 0.029035379480640125,
+0.029927514170711773, 0.030793400832288081, 0.031633039465369044, 0.032446430069954665,
+0.033233572646044943, 0.033993548114690242, 0.034726356475890563, 0.035431997729645899,
+0.036110471875956257, 0.036761778914821637, 0.037385521747744066, 0.037981700374723544,
+0.038550314795760078, 0.039091365010853661, 0.039604851020004293, 0.040090869254158189,
+0.040549419713315354, 0.04098050239747579, 0.04138411730663949, 0.041760264440806459,
+0.042109489103303525, 0.042431791294130689, 0.042727171013287955, 0.042995628260775319,
+0.043237163036592786, 0.043452739221912881, 0.04364235681673561, 0.043806015821060973,
+0.043943716234888963, 0.044055458058219588, 0.044142563854474771, 0.044205033623654522,
+0.044242867365758831, 0.0442560650807877, 0.044244626768741128, 0.044210196860847574,
+0.044152775357107037, 0.044072362257519516, 0.043968957562085013, 0.043842561270803528,
+0.043695084680567479, 0.043526527791376869, 0.043336890603231697, 0.043126173116131962,
+0.042894375330077665, 0.042643617668730899, 0.042373900132091663, 0.042085222720159958,
+0.041777585432935783, 0.04145098827041914, 0.041107717668524384, 0.040747773627251509,
+0.040371156146600515, 0.039977865226571409, 0.039567900867164184, 0.03914366017332388,
+0.03870514314505049, 0.038252349782344021, 0.037785280085204473, 0.037303934053631846,
+0.036810769216667365, 0.036305785574311029, 0.03578898312656284, 0.035260361873422796,
+0.034719921814890906, 0.034170133688292061, 0.033610997493626268, 0.033042513230893522,
+0.032464680900093829, 0.031877500501227188, 0.031283416261199085, 0.030682428180009522,
+0.030074536257658505, 0.029459740494146031, 0.028838040889472099, 0.02821181104051813,
+0.027581050947284125, 0.026945760609770088, 0.026305940027976014, 0.025661589201901903,
+0.025014975672061464, 0.024366099438454695, 0.023714960501081593, 0.023061558859942162,
+0.022405894515036402, 0.021750095582964171, 0.021094162063725472, 0.020438093957320304,
+0.019781891263748668, 0.019125553983010562, 0.018471049387752733, 0.017818377477975177,
+0.017167538253677894, 0.016518531714860885, 0.01587135786152415, 0.015227796582617531,
+0.014587847878141024, 0.013951511748094633, 0.013318788192478356, 0.012689677211292192,
+0.0120657571563202, 0.011447028027562379, 0.010833489825018729, 0.01022514254868925,
+0.0096219861985739411, 0.0090253813042305894, 0.0084353278656591948, 0.0078518258828597573,
+0.0072748753558322752, 0.0067044762845767502, 0.0061417699436213391, 0.0055867563329660419,
+0.0050394354526108586, 0.0044998073025557892, 0.0039678718828008337, 0.003444545010787425,
+0.002929826686515564, 0.0024237169099852502, 0.001926215681196484, 0.001437323000149265,
+0.00095773582935487528, 0.00048745416881331496, 2.6478018524583912e-05, -0.00042519262151131774,
+-0.00086755775129439012, -0.0013001404589845658, -0.0017229407445818448, -0.0021359586080862271,
+-0.0025391940494977126, -0.0029326470688163016, -0.0033160431831510372, -0.0036893823925019196,
+-0.0040526646968689489, -0.0044058900962521252, -0.0047490585906514475, -0.0050820948242556669,
+-0.0054049987970647825, -0.0057177705090787944, -0.0060204099602977025, -0.0063129171507215077,
+-0.0065953867720471805, -0.0068678188242747218, -0.0071302133074041306, -0.007382570221435408,
+-0.0076248895663685529, -0.0078574377769770869, -0.008080214853261011, -0.0082932207952203241,
+-0.0084964556028550263, -0.0086899192761651159, -0.008874005184422263, -0.0090487133276264658,
+-0.0092140437057777243, -0.0093699963188760386, -0.0095165711669214087, -0.0096543007541486144,
+-0.0097831850805576558, -0.0099032241461485329, -0.010014417950921246, -0.010116766494875794,
+-0.0102108929244249, -0.010296797239568566, -0.01037447944030679, -0.010443939526639572,
+-0.010505177498566911, -0.0105588881593165, -0.010605071508888338, -0.010643727547282426,
+-0.010674856274498764, -0.010698457690537351, -0.010715315057499638, -0.010725428375385624,
+-0.01072879764419531, -0.010725422863928694, -0.010715304034585779, -0.010699231560383871,
+-0.010677205441322972, -0.01064922567740308, -0.010615292268624196, -0.01057540521498632,
+-0.01053038824848347, -0.010480241369115644, -0.010424964576882844, -0.010364557871785068,
+-0.010299021253822318, -0.010229182770413276, -0.010155042421557944, -0.010076600207256323,
+-0.0099938561275084107, -0.0099068101823142074, -0.009816281685149076, -0.0097222706360130147,
+-0.0096247770349060235, -0.0095238008818281043, -0.0094193421767792551, -0.0093121801136402983,
+-0.0092023146924112339, -0.0090897459130920635, -0.0089744737756827855, -0.0088564982801833999,
+-0.0087365626184833772, -0.0086146667905827156, -0.008490810796481417, -0.0083649946361794795,
+-0.0082372183096769049, -0.0081081738324291774, -0.0079778612044362953, -0.0078462804256982602,
+-0.0077134314962150723, -0.0075793144159867305, -0.0074445691419083582, -0.0073091956739799561,
+-0.0071731940122015244, -0.0070365641565730622, -0.0068993061070945702, -0.0067619889751130546,
+-0.0066246127606285161, -0.006487177463640954, -0.006349683084150369, -0.0062121296221567604,
+-0.0060750182618643685, -0.0059383490032731932, -0.0058021218463832347, -0.0056663367911944929,
+-0.0055309938377069677, -0.005396518012286005, -0.0052629093149316039, -0.0051301677456437652,
+-0.004998293304422489, -0.0048672859912677743, -0.0047375034528085143, -0.004608945689044709,
+-0.0044816126999763584, -0.0043555044856034616, -0.0042306210459260194, -0.0041072467899824225,
+-0.0039853817177726717, -0.003865025829296766, -0.0037461791245547056, -0.0036288416035464904,
+-0.0035132317610902688, -0.0033993495971860414, -0.0032871951118338075, -0.0031767683050335678,
+-0.0030680691767853217, -0.0029612469627661748, -0.0028563016629761266, -0.0027532332774151771,
+-0.0026520418060833263, -0.0025527272489805743, -0.0024553802232447049, -0.0023600007288757177,
+-0.0022665887658736127, -0.0021751443342383904, -0.0020856674339700502, -0.0019981907072418119,
+-0.0019127141540536755, -0.0018292377744056406, -0.0017477615682977075, -0.0016682855357298763,
+-0.0015907974625988266, -0.0015152973489045585, -0.001441785194647072, -0.0013702609998263672,
+-0.0013007247644424439, -0.001233120475371231, -0.0011674481326127283, -0.0011037077361669358,
+-0.0010418992860338537, -0.00098202278221348185, -0.000923991147769297, -0.00086780438270129938,
+-0.00081346248700948887, -0.00076096546069386549, -0.00071031330375442923, -0.00066138735093046366,
+-0.00061418760222196878, -0.00056871405762894459, -0.00052496671715139109, -0.00048294558078930828,
+-0.0004425123679028416, -0.00040366707849199098, -0.00036640971255675649, -0.00033074027009713806,
+-0.00029665875111313576, -0.00026400793437918283, -0.00023278781989527925, -0.00020299840766142501,
+-0.00017463969767762014, -0.00014771168994386462, -0.00011678371630922485, -8.1855776773700817e-05,
+-4.2927871337292538e-05,
+};
+
+static const snd_filter_t filter_31440_q0[801] = {
+0.97153112861551749, 0.97132378168205913, 0.97128231229536743, 0.97124479040851908,
+0.97121121602151406, 0.97118158913435226, 0.97115590974703381, 0.97113417785955869,
+0.97111166432405893, 0.97108836914053454, 0.9710642923089855, 0.97103943382941182,
+0.97101379370181351, 0.97098758799303952, 0.97096081670308976, 0.97093347983196421,
+0.97090557737966288, 0.97087710934618576, 0.97084841049653214, 0.97081948083070191,
+0.97079032034869517, 0.97076092905051181, 0.97073130693615195, 0.97070191873326539,
+0.97067276444185213, 0.97064384406191206, 0.9706151575934453, 0.97058670503645184,
+0.97055908408230296, 0.97053229473099867, 0.97050633698253908, 0.97048121083692407,
+0.97045691629415365, 0.97043418287300987, 0.97041301057349283, 0.97039339939560254,
+0.97037534933933889, 0.97035886040470198, 0.97034478336823538, 0.97033311822993906,
+0.97032386498981293, 0.9703170236478571, 0.97031259420407157, 0.97031153036745443,
+0.97031383213800571, 0.97031949951572549, 0.97032853250061368, 0.97034093109267028,
+0.97035772323620351, 0.97037890893121337, 0.97040448817769986, 0.97043446097566299,
+0.97046882732510276, 0.97050865146253407, 0.97055393338795692, 0.97060467310137133,
+0.97066087060277728, 0.97072252589217489, 0.97079069185673661, 0.97086536849646254,
+0.97094655581135259, 0.97103425380140684, 0.97112846246662521, 0.97123016979551813,
+0.97133937578808549, 0.9714560804443273, 0.97158028376424366, 0.97171198574783446,
+0.97185205176066625, 0.97200048180273901, 0.97215727587405276, 0.97232243397460749,
+0.9724959561044032, 0.97267852349559458, 0.97287013614818163, 0.97307079406216435,
+0.97328049723754273, 0.97349924567431667, 0.97372747201098286, 0.97396517624754131,
+0.97421235838399201, 0.97446901842033495, 0.97473515635657004, 0.97501089201480673,
+0.97529622539504501, 0.97559115649728489, 0.97589568532152637, 0.97620981186776945,
+0.97653328488426983, 0.9768661043710275, 0.97720827032804247, 0.97755978275531463,
+0.97792064165284409, 0.97829017804356266, 0.97866839192747035, 0.97905528330456704,
+0.97945085217485284, 0.97985509853832775, 0.980266905284081, 0.9806862724121127,
+0.98111319992242285, 0.98154768781501145, 0.9819897360898785, 0.98243776179808928,
+0.98289176493964392, 0.98335174551454241, 0.98381770352278464, 0.98428963896437072,
+0.98476549885451725, 0.98524528319322435, 0.98572899198049191, 0.98621662521632003,
+0.98670818290070861, 0.98720115787934848, 0.98769555015223975, 0.98819135971938232,
+0.98868858658077619, 0.98918723073642134, 0.98968438437325545, 0.99018004749127841,
+0.99067422009049022, 0.99116690217089098, 0.99165809373248059, 0.99214456306681442,
+0.99262631017389247, 0.99310333505371462, 0.99357563770628099, 0.99404321813159158,
+0.99450259950850728, 0.9949537818370281, 0.99539676511715414, 0.99583154934888529,
+0.99625813453222156, 0.99667289735546771, 0.99707583781862374, 0.99746695592168966,
+0.99784625166466545, 0.99821372504755113, 0.99856579229030495, 0.99890245339292705,
+0.99922370835541741, 0.99952955717777603, 0.99981999986000292, 1.000091581354932,
+1.0003443016625635, 1.0005781607828972, 1.0007931587159331, 1.0009892954616713,
+1.0011634511163083, 1.0013156256798443, 1.0014458191522793, 1.0015540315336131,
+1.0016402628238459, 1.0017018713918779, 1.0017388572377095, 1.0017512203613403,
+1.0017389607627707, 1.0017020784420003, 1.0016385837090387, 1.0015484765638856,
+1.001431757006541, 1.0012884250370049, 1.0011184806552773, 1.0009207390209975,
+1.0006952001341656, 1.0004418639947814, 1.000160730602845, 0.99985179995835649,
+0.99951483356004034, 0.9991498314078967, 0.99875679350192548, 0.99833571984212677,
+0.99788661042850058, 0.99741028794447595, 0.99690675239005289, 0.9963760037652315,
+0.99581804207001168, 0.99523286730439353, 0.99462244618898721, 0.99398677872379271,
+0.99332586490881014, 0.9926397047440394, 0.99192829822948048, 0.9911948000434837,
+0.99043921018604908, 0.9896615286571766, 0.98886175545686628, 0.9880398905851181,
+0.98720027814506894, 0.98634291813671893, 0.98546781056006794, 0.98457495541511597,
+0.98366435270186314, 0.98274148823928198, 0.98180636202737259, 0.98085897406613498,
+0.97989932435556903, 0.97892741289567486, 0.97794976777150533, 0.97696638898306032,
+0.97597727653033994, 0.9749824304133442, 0.97398185063207299, 0.97298295508299115,
+0.97198574376609859, 0.97099021668139529, 0.96999637382888126, 0.96900421520855651,
+0.9680218447912845, 0.96704926257706525, 0.96608646856589864, 0.96513346275778478,
+0.96419024515272356, 0.96326535537433389, 0.96235879342261577, 0.96147055929756919,
+0.96060065299919417, 0.9597490745274907, 0.95892450741171109, 0.95812695165185546,
+0.9573564072479237, 0.95661287419991592, 0.955896352507832, 0.95521534222608639,
+0.95456984335467909, 0.9539598558936101, 0.95338537984287941, 0.95284641520248703,
+0.95235092389340936, 0.95189890591564652, 0.9514903612691985, 0.95112528995406531,
+0.95080369197024694, 0.95053262552721751, 0.95031209062497701, 0.95014208726352545,
+0.95002261544286282, 0.94995367516298912, 0.94994105667692541, 0.94998475998467169,
+0.95008478508622785, 0.95024113198159399, 0.95045380067077012, 0.9507269614147742,
+0.95106061421360633, 0.9514547590672664, 0.95190939597575441, 0.95242452493907048,
+0.95300236537938643, 0.95364291729670236, 0.95434618069101829, 0.9551121555623342,
+0.95594084191064999, 0.95683222655561084, 0.95778630949721666, 0.95880309073546754,
+0.95988257027036339, 0.96102474810190419, 0.96222715011358473, 0.963489776305405,
+0.96481262667736511, 0.96619570122946496, 0.96763899996170455, 0.96913742368054334,
+0.97069097238598134, 0.97229964607801866, 0.97396344475665519, 0.97568236842189104,
+0.97744860287964119, 0.97926214812990575, 0.98112300417268461, 0.98303117100797788,
+0.98498664863578544, 0.9869789195839862, 0.98900798385258015, 0.99107384144156729,
+0.99317649235094763, 0.99531593658072115, 0.99747902993798043, 0.99966577242272547,
+1.0018761640349563, 1.0041102047746728, 1.0063678946418753, 1.0086336593139498,
+1.0109074987908964, 1.0131894130727148, 1.0154794021594054, 1.017777466050968,
+1.0200658705284258, 1.0223446155917786, 1.0246137012410266, 1.0268731274761698,
+1.0291228942972082, 1.0313434788271343, 1.0335348810659482, 1.0356971010136498,
+1.0378301386702393, 1.0399339940357166, 1.0419877989535393, 1.0439915534237074,
+1.0459452574462211, 1.0478489110210802, 1.0497025141482847, 1.0514843717257212,
+1.0531944837533895, 1.0548328502312898, 1.0563994711594218, 1.0578943465377857,
+1.0592955276731602, 1.0606030145655452, 1.0618168072149408, 1.0629369056213469,
+1.0639633097847636, 1.0648744308346723, 1.0656702687710728, 1.0663508235939652,
+1.0669160953033494, 1.0673660838992256, 1.0676801941390213, 1.0678584260227362,
+1.0679007795503703, 1.0678072547219237, 1.0675778515373966, 1.0671936040291321,
+1.06665451219713, 1.0659605760413906, 1.0651117955619138, 1.0641081707586997,
+1.0629329800643046, 1.0615862234787286, 1.0600679010019716, 1.0583780126340336,
+1.0565165583749148, 1.0544696364904962, 1.0522372469807779, 1.04981938984576,
+1.0472160650854423, 1.0444272726998249, 1.0414424463507008, 1.03826158603807,
+1.0348846917619323, 1.0313117635222881, 1.0275428013191372, 1.0235710096916621,
+1.0193963886398629, 1.0150189381637396, 1.010438658263292, 1.0056555489385204,
+1.0006669245731974, 0.99547278516732329, 0.99007313072089809, 0.98446796123392166,
+0.97865727670639402, 0.97264273214811081, 0.96642432755907204, 0.9600020629392777,
+0.9533759382887278, 0.94654595360742233, 0.93951821735744601, 0.93229272953879871,
+0.92486949015148057, 0.91724849919549156, 0.9094297566708317, 0.90142380964599533,
+0.89323065812098235, 0.88485030209579285, 0.87628274157042685, 0.86752797654488423,
+0.85860084983201368, 0.84950136143181509, 0.84022951134428858, 0.83078529956943403,
+0.82116872610725156, 0.81139866120035165, 0.8014751048487343, 0.79139805705239963,
+0.78116751781134752, 0.77078348712557798, 0.76026847625778771, 0.7496224852079767,
+0.73884551397614495, 0.72793756256229247, 0.71689863096641926, 0.70575437097663485,
+0.69450478259293935, 0.68314986581533266, 0.67168962064381488, 0.6601240470783859,
+0.64848134841976834, 0.63676152466796221, 0.62496457582296749, 0.61309050188478409,
+0.60113930285341211, 0.58914106008513045, 0.57709577357993902, 0.56500344333783781,
+0.55286406935882682, 0.54067765164290615, 0.52847542466509911, 0.51625738842540569,
+0.5040235429238259, 0.49177388816035972, 0.47950842413500716, 0.46725876937154098,
+0.45502492386996118, 0.44280688763026776, 0.43060466065246072, 0.41841824293654006,
+0.40627886895752913, 0.39418653871542791, 0.38214125221023648, 0.37014300944195477,
+0.35819181041058279, 0.34631773647239944, 0.33452078762740467, 0.32280096387559853,
+0.31115826521698098, 0.29959269165155206, 0.28813244648003428, 0.27677752970242764,
+0.26552794131873214, 0.25438368132894779, 0.24334474973307457, 0.23243679831922209,
+0.22165982708739035, 0.21101383603757937, 0.20049882516978912, 0.19011479448401961,
+0.1798842552429675, 0.1698072074466328, 0.15988365109501551, 0.15011358618811563,
+0.14049701272593315, 0.13105280095107866, 0.12178095086355213, 0.11268146246335359,
+0.10375433575048303, 0.094999570724940446, 0.086432010199574416, 0.078051654174384921,
+0.069858502649371976, 0.06185255562453558, 0.054033813099875719, 0.046412822143886735,
+0.038989582756568622, 0.031764094937921379, 0.024736358687945006, 0.017906374006639508,
+0.011280249356089586, 0.0048579847362952419, -0.0013604198527435232, -0.0073749644110267104,
+-0.013185648938554319, -0.01879081842553075, -0.024190472871956005, -0.029384612277830086,
+-0.034373236643152991, -0.039156345967924715, -0.043736625868372292, -0.048114076344495722,
+-0.052288697396295006, -0.056260489023770142, -0.060029451226921132, -0.063602379466565398,
+-0.066979273742702933, -0.07016013405533375, -0.073144960404457837, -0.075933752790075193,
+-0.078537077550392853, -0.080954934685410818, -0.083187324195129086, -0.08523424607954766,
+-0.087095700338666537, -0.088785588706604468, -0.090303911183361465, -0.09165066776893753,
+-0.092825858463332647, -0.093829483266546831, -0.094678263746023616, -0.095372199901763002,
+-0.095911291733764989, -0.096295539242029576, -0.096524942426556765, -0.096618467255003268,
+-0.096576113727369073, -0.096397881843654193, -0.096083771603858628, -0.095633783007982365,
+-0.09506851129859803, -0.094387956475705623, -0.09359211853930513, -0.092680997489396566,
+-0.09165459332597993, -0.090534494919573827, -0.089320702270178257, -0.088013215377793205,
+-0.086612034242418687, -0.085117158864054701, -0.083550537935922611, -0.081912171458022431,
+-0.080202059430354147, -0.078420201852917759, -0.076566598725713281, -0.07466294515085424,
+-0.072709241128340638, -0.070705486658172473, -0.068651681740349746, -0.066547826374872457,
+-0.064414788718282961, -0.062252568770581267, -0.060061166531767365, -0.057840582001841258,
+-0.055590815180802944, -0.053331388945659773, -0.051062303296411739, -0.048783558233058841,
+-0.046495153755601086, -0.044197089864038468, -0.04190710077734789, -0.039625186495529353,
+-0.037351347018582857, -0.035085582346508402, -0.032827892479305988, -0.03059385173958936,
+-0.028383460127358512, -0.026196717642613443, -0.024033624285354153, -0.021894180055580643,
+-0.019791529146200325, -0.017725671557213194, -0.015696607288619251, -0.013704336340418496,
+-0.01174885871261093, -0.0098406918773177119, -0.0079798358345388419, -0.0061662905842743195,
+-0.0044000561265241447, -0.0026811324612883176, -0.0010173337826517475, 0.00059133990938556595,
+0.0021448886148236223, 0.003643312333662422, 0.0050866110659019649, 0.0064696856180017689,
+0.0077925359899618336, 0.0090551621817821591, 0.010257564193462746, 0.011399742025003594,
+0.012479221559899438, 0.01349600279815028, 0.014450085739756119, 0.015341470384716956,
+0.016170156733032789, 0.016936131604348665, 0.017639394998664581, 0.01827994691598054,
+0.018857787356296538, 0.01937291631961258, 0.01982755322810064, 0.020221698081760723,
+0.020555350880592824, 0.020828511624596945, 0.021041180313773084, 0.021197527209139259,
+0.021297552310695467, 0.021341255618441711, 0.021328637132377988, 0.021259696852504298,
+0.02114022503184167, 0.020970221670390105, 0.020749686768149603, 0.020478620325120163,
+0.020157022341301786, 0.019791951026168597, 0.019383406379720594, 0.01893138840195778,
+0.018435897092880155, 0.017896932452487718, 0.017322456401756989, 0.016712468940687966,
+0.016066970069280651, 0.015385959787535042, 0.014669438095451138, 0.013925905047443321,
+0.013155360643511589, 0.012357804883655944, 0.011533237767876384, 0.01068165929617291,
+0.0098117529977978894, 0.0089235188727513227, 0.0080169569210332085, 0.0070920671426435477,
+0.0061488495375823394, 0.0051958437294684322, 0.0042330497183018252, 0.0032604675040825183,
+0.0022780970868105121, 0.0012859384664858067, 0.00029209561397180485, -0.00070343147073149287,
+-0.0017006427876240869, -0.0026995383367059774, -0.0037001181179771641, -0.0046949642349729459,
+-0.0056840766876933221, -0.0066674554761382938, -0.00764510060030786, -0.0086170120602020207,
+-0.0095766617707679202, -0.010524049732005559, -0.011459175943914938, -0.012382040406496056,
+-0.013292643119748912, -0.014185498264700835, -0.015060605841351824, -0.015917965849701881,
+-0.016757578289751003, -0.017579443161499193, -0.018379216361809524, -0.019156897890681999,
+-0.01991248774811662, -0.020645985934113386, -0.021357392448672293, -0.022043552613443054,
+-0.022704466428425669, -0.023340133893620139, -0.023950555009026459, -0.024535729774644632,
+-0.02509369146986442, -0.025624440094685823, -0.026127975649108841, -0.026604298133133471,
+-0.027053407546759715, -0.027474481206558432, -0.027867519112529621, -0.028232521264673283,
+-0.028569487662989418, -0.028878418307478025, -0.029159551699414414, -0.029412887838798585,
+-0.029638426725630541, -0.029836168359910278, -0.030006112741637801, -0.030149444711173878,
+-0.030266164268518511, -0.030356271413671698, -0.030419766146633442, -0.03045664846740374,
+-0.030468908065973428, -0.030456544942342501, -0.030419559096510965, -0.030357950528478818,
+-0.030271719238246057, -0.030163506856912208, -0.030033313384477265, -0.02988113882094123,
+-0.029706983166304102, -0.029510846420565885, -0.029295848487529943, -0.029061989367196273,
+-0.028809269059564879, -0.028537687564635761, -0.028247244882408918, -0.027941396060050316,
+-0.027620141097559954, -0.027283479994937829, -0.026931412752183945, -0.026563939369298302,
+-0.026184643626322529, -0.02579352552325663, -0.025390585060100602, -0.024975822236854444,
+-0.024549237053518157, -0.024114452821787008, -0.023671469541661001, -0.023220287213140133,
+-0.022760905836224404, -0.022293325410913813, -0.021821022758347415, -0.021343997878525211,
+-0.020862250771447197, -0.020375781437113376, -0.019884589875523745, -0.019391907795123009,
+-0.018897735195911165, -0.018402072077888212, -0.01790491844105415, -0.017406274285408981,
+-0.016909047424015122, -0.016413237856872574, -0.01591884558398134, -0.015425870605341417,
+-0.014934312920952804, -0.0144466796851247, -0.013962970897857108, -0.013483186559150024,
+-0.013007326669003451, -0.012535391227417387, -0.012069433219175137, -0.011609452644276702,
+-0.011155449502722082, -0.010707423794511277, -0.010265375519644286, -0.0098308876270557181,
+-0.0094039601167455709, -0.0089845929887138465, -0.008572786242960543, -0.0081685398794856621,
+-0.0077729710091998588, -0.0073860796321031331, -0.007007865748195485, -0.0066383293574769145,
+-0.0062774704599474207, -0.0059259580326752074, -0.0055837920756602738, -0.0052509725889026207,
+-0.0049274995724022472, -0.0046133730261591534, -0.0043088442019176536, -0.004013913099677747,
+-0.0037285797194394335, -0.0034528440612027131, -0.0031867061249675858, -0.002930046088624687,
+-0.0026828639521740165, -0.0024451597156155743, -0.0022169333789493601, -0.0019981849421753742,
+-0.0017884817667970405, -0.0015878238528143588, -0.0013962112002273289, -0.001213643809035951,
+-0.0010401216792402252, -0.00087496357868548189, -0.00071816950737172119, -0.00056973946529894313,
+-0.00042967345246714772, -0.00029797146887633485, -0.00017376814896000219, -5.7063492718149734e-05,
+5.2142499849222509e-05, 0.00015384982874211452, 0.00024805849396052635, 0.00033575648401476879,
+0.00041694379890484183, 0.00049162043863074545, 0.00055978640319247967, 0.00062144169259004459,
+0.00067763919399604629, 0.00072837890741048487, 0.00077366083283336023, 0.00081348497026467249,
+0.00084785131970442152, 0.00087782411766753915, 0.00090340336415402529, 0.00092458905916388003,
+0.00094138120269710338, 0.00095377979475369523, 0.00096281277964185938, 0.00096848015736159584,
+0.0009707819279129047, 0.00096971809129578587, 0.00096528864751023935, 0.00095844730555442157,
+0.00094919406542833267, 0.00093752892713197251, 0.00092345189066534111, 0.00090696295602843858,
+0.00088891289976482846, 0.00086930172187451075, 0.00084812942235748545, 0.00082539600121375267,
+0.00080110145844331231, 0.00077597531282827135, 0.0007500175643686298, 0.00072322821306438755,
+0.00069560725891554471, 0.00066715470192210127, 0.0006384682334553732, 0.00060954785351536049,
+0.00058039356210206315, 0.00055100535921548106, 0.00052138324485561435, 0.00049199194667230738,
+0.00046283146466556002, 0.00043390179883537235, 0.00040520294918174439, 0.00037673491570467614,
+0.00034883246340336764, 0.0003214955922778189, 0.00029472430232802991, 0.00026851859355400069,
+0.00024287846595573119, 0.00021801998638208101, 0.00019394315483305013, 0.00017064797130863854,
+0.00014813443580884625, 0.00012640254833367324, 0.00010072316101520211, 7.1096273853432862e-05,
+3.7521886848365499e-05,
+};
+
+static const snd_filter_t filter_44100_q0[601] = {
+0.98004336330827768, 0.97985547317280242, 0.97981789514570738, 0.97978018098753727,
+0.97974233069829209, 0.97970434427797182, 0.97966622172657647, 0.97962796304410604,
+0.97958655222616642, 0.97954198927275749, 0.97949427418387924, 0.9794434069595318,
+0.97938938759971506, 0.97933208549898509, 0.97927150065734192, 0.97920763307478553,
+0.97914048275131593, 0.97907004968693323, 0.97899657312510324, 0.97892005306582608,
+0.97884048950910174, 0.97875788245493023, 0.97867223190331154, 0.97858424715213077,
+0.97849392820138781, 0.97840127505108276, 0.97830628770121564, 0.97820896615178643,
+0.9781105597961739, 0.97801106863437803, 0.97791049266639896, 0.97780883189223655,
+0.97770608631189082, 0.97760407790613568, 0.97750280667497114, 0.97740227261839718,
+0.97730247573641382, 0.97720341602902105, 0.977107464517874, 0.97701462120297267,
+0.97692488608431705, 0.97683825916190714, 0.97675474043574306, 0.97667716868758669,
+0.97660554391743815, 0.97653986612529742, 0.9764801353111644, 0.9764263514750392,
+0.97638166502614376, 0.97634607596447798, 0.97631958429004195, 0.97630219000283569,
+0.97629389310285919, 0.97629793123692177, 0.97631430440502354, 0.97634301260716438,
+0.97638405584334442, 0.97643743411356365, 0.97650618539481071, 0.97659030968708571,
+0.97668980699038854, 0.97680467730471932, 0.97693492063007792, 0.97708305284818187,
+0.97724907395903127, 0.97743298396262601, 0.9776347828589661, 0.97785447064805164,
+0.97809369565229454, 0.97835245787169478, 0.97863075730625237, 0.97892859395596732,
+0.97924596782083961, 0.97958331938107512, 0.97994064863667374, 0.98031795558763557,
+0.98071524023396051, 0.98113250257564866, 0.98156867024159278, 0.98202374323179276,
+0.9824977215462487, 0.98299060518496062, 0.98350239414792839, 0.98403029230839445,
+0.98457429966635879, 0.98513441622182141, 0.98571064197478231, 0.98630297692524138,
+0.98690680338857872, 0.98752212136479434, 0.98814893085388822, 0.98878723185586037,
+0.9894370243707109, 0.99009190432040084, 0.99075187170493029, 0.99141692652429914,
+0.9920870687785075, 0.99276229846755537, 0.9934346197298054, 0.99410403256525759,
+0.99477053697391205, 0.99543413295576866, 0.99609482051082754, 0.99674341236263686,
+0.99737990851119673, 0.99800430895650705, 0.99861661369856791, 0.99921682273737933,
+0.99979509484932783, 1.0003514300344134, 1.0008858282926361, 1.0013982896239959,
+1.0018888140284929, 1.0023475906836343, 1.0027746195894203, 1.0031699007458506,
+1.0035334341529254, 1.0038652198106446, 1.0041563139098018, 1.0044067164503967,
+1.0046164274324294, 1.0047854468558999, 1.0049137747208083, 1.0049941644195826,
+1.0050266159522225, 1.0050111293187283, 1.0049477045190998, 1.0048363415533372,
+1.0046723802437707, 1.0044558205904002, 1.0041866625932256, 1.0038649062522471,
+1.0034905515674646, 1.0030622846840986, 1.0025801056021491, 1.0020440143216161,
+1.0014540108424996, 1.0008100951647996, 1.0001149310397885, 0.99936851846746644,
+0.99857085744783336, 0.99772194798088931, 0.99682179006663418, 0.99587740612194431,
+0.99488879614681969, 0.99385596014126032, 0.99277889810526621, 0.99165761003883734,
+0.99050357725681626, 0.98931679975920306, 0.98809727754599763, 0.98684501061720009,
+0.98555999897281032, 0.98425792755522989, 0.98293879636445869, 0.98160260540049682,
+0.98024935466334429, 0.97887904415300109, 0.97751094472482403, 0.97614505637881321,
+0.97478137911496865, 0.97341991293329033, 0.97206065783377815, 0.97072547381807905,
+0.96941436088619293, 0.96812731903811988, 0.96686434827385981, 0.96562544859341271,
+0.96443374284323102, 0.96328923102331476, 0.96219191313366392, 0.96114178917427839,
+0.96013885914515829, 0.95920589344053075, 0.9583428920603958, 0.95754985500475343,
+0.95682678227360363, 0.95617367386694641, 0.95561114169858408, 0.95513918576851664,
+0.95475780607674399, 0.95446700262326623, 0.95426677540808336, 0.95417368801275715,
+0.9541877404372876, 0.95430893268167483, 0.95453726474591871, 0.95487273663001926,
+0.95532602957170343, 0.95589714357097122, 0.95658607862782252, 0.95739283474225745,
+0.958317411914276, 0.95936295359137036, 0.96052945977354054, 0.96181693046078653,
+0.96322536565310835, 0.96475476535050586, 0.96639941039050758, 0.96815930077311341,
+0.97003443649832344, 0.97202481756613757, 0.9741304439765559, 0.97633585805612444,
+0.97864105980484328, 0.98104604922271232, 0.98355082630973156, 0.98615539106590111,
+0.98883422814953792, 0.99158733756064199, 0.99441471929921332, 0.99731637336525192,
+1.0002922997587578, 1.0033072286989153, 1.0063611601857247, 1.0094540942191859,
+1.0125860307992987, 1.0157569699260633, 1.0189228649577355, 1.0220837158943152,
+1.0252395227358027, 1.0283902854821976, 1.0315360041335002, 1.034625468874969,
+1.0376586797066039, 1.0406356366284051, 1.0435563396403724, 1.0464207887425059,
+1.0491728305801504, 1.0518124651533058, 1.0543396924619721, 1.0567545125061495,
+1.0590569252858377, 1.0611885471142481, 1.0631493779913808, 1.0649394179172356,
+1.0665586668918126, 1.0680071249151117, 1.0692272364562463, 1.070219001515216,
+1.070982420092021, 1.0715174921866613, 1.0718242177991368, 1.0718491135338761,
+1.0715921793908791, 1.0710534153701461, 1.0702328214716768, 1.0691303976954711,
+1.0676999512443459, 1.0659414821183011, 1.0638549903173367, 1.0614404758414524,
+1.0586979386906485, 1.055591478805058, 1.052121096184681, 1.0482867908295173,
+1.0440885627395671, 1.0395264119148302, 1.0345773078010239, 1.0292412503981478,
+1.0235182397062021, 1.0174082757251868, 1.0109113584551017, 1.0040193046306862,
+0.99673211425194053, 0.98904978731886439, 0.98097232383145794, 0.97249972378972105,
+0.96363987879864144, 0.9543927888582191, 0.94475845396845393, 0.93473687412934603,
+0.92432804934089541, 0.91355632946107601, 0.90242171448988795, 0.89092420442733111,
+0.8790637992734055, 0.86684049902811122, 0.85429458690799231, 0.84142606291304878,
+0.82823492704328061, 0.81472117929868781, 0.80088481967927039, 0.78678065350764881,
+0.77240868078382297, 0.75776890150779297, 0.74286131567955871, 0.7276859232991203,
+0.71230980521505782, 0.69673296142737129, 0.68095539193606081, 0.66497709674112626,
+0.64879807584256777, 0.63249473071244622, 0.61606706135076161, 0.59951506775751406,
+0.58283874993270346, 0.56603810787632991, 0.5491953641359727, 0.53231051871163182,
+0.51538357160330728, 0.49841452281099913, 0.48140337233470731, 0.46443432354239911,
+0.44750737643407457, 0.43062253100973369, 0.41377978726937642, 0.39697914521300282,
+0.38030282738819221, 0.36375083379494466, 0.34732316443326011, 0.33101981930313856,
+0.31484079840458007, 0.29886250320964558, 0.2830849337183351, 0.26750808993064862,
+0.25213197184658614, 0.2369565794661477, 0.22204899363791347, 0.20740921436188345,
+0.19303724163805763, 0.17893307546643603, 0.16509671584701863, 0.15158296810242583,
+0.13839183223265766, 0.12552330823771413, 0.11297739611759519, 0.10075409587230089,
+0.088893690718375301, 0.077396180655818464, 0.066261565684630347, 0.055489845804810978,
+0.045081021016360336, 0.035059441177252446, 0.025425106287487315, 0.016178016347064936,
+0.0073181713559853159, -0.00115442868575155, -0.0092318921731580489, -0.016914219106234179,
+-0.024201409484979942, -0.031093463309395337, -0.037590380579480366, -0.043700344560495749,
+-0.04942335525244148, -0.054759412655317564, -0.059708516769124004, -0.064270667593860797,
+-0.06846889568381101, -0.072303201038974627, -0.075773583659351662, -0.078880043544942116,
+-0.081622580695745989, -0.084037095171630188, -0.086123586972594715, -0.087882056098639569,
+-0.08931250254976475, -0.090414926325970257, -0.091235520224439579, -0.091774284245172699,
+-0.092031218388169619, -0.092006322653430339, -0.091699597040954858, -0.091164524946314648,
+-0.090401106369509696, -0.08940934131054, -0.088189229769405561, -0.086740771746106379,
+-0.085121522771529373, -0.083331482845674529, -0.08137065196854186, -0.079239030140131367,
+-0.076936617360443035, -0.074521797316265681, -0.07199457000759929, -0.069354935434443876,
+-0.066602893596799426, -0.063738444494665952, -0.060817741482698653, -0.057840784560897536,
+-0.0548075737292626, -0.051718108987793845, -0.048572390336491272, -0.04542162759009629,
+-0.042265820748608907, -0.039104969812029114, -0.035939074780356919, -0.032768135653592316,
+-0.029636199073479457, -0.026543265040018339, -0.023489333553208966, -0.020474404613051334,
+-0.017498478219545442, -0.014596824153506825, -0.011769442414935478, -0.0090163330038314018,
+-0.0063374959201945961, -0.0037329311640250627, -0.0012281540770057728, 0.0011768353408632736,
+0.0034820370895820756, 0.0056874511691506341, 0.0077930775795689491, 0.0097834586473831125,
+0.011658594372593126, 0.013418484755198988, 0.015063129795200698, 0.016592529492598259,
+0.018000964684920018, 0.019288435372165975, 0.02045494155433613, 0.021500483231430483,
+0.022425060403449035, 0.023231816517883988, 0.023920751574735347, 0.024491865574003107,
+0.024945158515687273, 0.02528063039978784, 0.025508962464031712, 0.025630154708418892,
+0.025644207132949376, 0.025551119737623168, 0.025350892522440265, 0.025060089068962507,
+0.024678709377189897, 0.024206753447122434, 0.023644221278760116, 0.022991112872102943,
+0.022268040140953186, 0.021475003085310845, 0.020612001705175916, 0.019679036000548402,
+0.018676105971428304, 0.01762598201204281, 0.016528664122391918, 0.01538415230247563,
+0.014192446552293946, 0.012953546871846865, 0.011690576107586776, 0.010403534259513675,
+0.0090924213276275655, 0.0077572373119284459, 0.0063979822124163171, 0.0050365160307379656,
+0.0036728387668933911, 0.0023069504208825934, 0.00093885099270557245, -0.00043145951763767158,
+-0.0017847102547902218, -0.0031209012187520782, -0.0044400324095232408, -0.0057421038271037094,
+-0.0070271154714934845, -0.0082793824002910747, -0.00949890461349648, -0.0106856821111097,
+-0.011839714893130734, -0.012961002959559584, -0.014038064995553684, -0.015070901001113033,
+-0.016059510976237631, -0.017003894920927479, -0.017904052835182576, -0.018752962302126652,
+-0.019550623321759705, -0.020297035894081737, -0.020992200019092751, -0.021636115696792742,
+-0.022226119175909227, -0.022762210456442208, -0.023244389538391683, -0.023672656421757653,
+-0.024047011106540121, -0.024368767447518612, -0.024637925444693131, -0.024854485098063678,
+-0.025018446407630252, -0.025129809373392854, -0.025193234173021259, -0.025208720806515469,
+-0.025176269273875482, -0.025095879575101298, -0.024967551710192919, -0.024798532286722359,
+-0.024588821304689618, -0.024338418764094698, -0.024047324664937596, -0.023715539007218314,
+-0.023352005600143493, -0.022956724443713137, -0.022529695537927243, -0.022070918882785812,
+-0.021580394478288845, -0.021067933146928994, -0.020533534888706257, -0.019977199703620638,
+-0.019398927591672135, -0.018798718552860746, -0.018186413810799867, -0.017562013365489501,
+-0.016925517216929645, -0.0162769253651203, -0.015616237810061466, -0.01495264182820483,
+-0.014286137419550394, -0.013616724584098157, -0.012944403321848119, -0.01226917363280028,
+-0.011599031378591914, -0.010933976559223018, -0.010274009174693595, -0.0096191292250036448,
+-0.0089693367101531668, -0.0083310357081809588, -0.0077042262190870209, -0.0070889082428713529,
+-0.0064850817795339558, -0.0058927468290748287, -0.0053165210761139678, -0.0047564045206513741,
+-0.0042123971626870475, -0.0036844990022209881, -0.0031727100392531958, -0.0026798264005413346,
+-0.0022058480860854051, -0.001750775095885407, -0.0013146074299413405, -0.00089734508825320544,
+-0.00050006044192823715, -0.00012275349096643577, 0.00023457576463219875, 0.00057192732486766647,
+0.00088930118973996734, 0.0011871378394549055, 0.0014654372740124813, 0.0017241994934126944,
+0.0019634244976555449, 0.0021831122867410329, 0.0023849111830811457, 0.0025688211866758833,
+0.0027348422975252457, 0.0028829745156292328, 0.0030132178409878448, 0.0031280881553185699,
+0.0032275854586214085, 0.0033117097508963602, 0.0033804610321434255, 0.0034338393023626039,
+0.0034748825385426435, 0.0035035907406835444, 0.0035199639087853071, 0.003524002042847931,
+0.0035157051428714161, 0.0034983108556651604, 0.0034718191812291637, 0.0034362301195634258,
+0.0033915436706679469, 0.0033377598345427271, 0.003278029020409726, 0.0032123512282689437,
+0.0031407264581203797, 0.0030631547099640344, 0.0029796359837999079, 0.0028930090613900443,
+0.0028032739427344437, 0.0027104306278331065, 0.0026144791166860322, 0.0025154194092932214,
+0.0024156225273098348, 0.0023150884707358729, 0.0022138172395713357, 0.0021118088338162228,
+0.0020090632534705347, 0.0019074024793081334, 0.0018068265113290196, 0.0017073353495331927,
+0.0016089289939206529, 0.0015116074444914004, 0.0014166200946242602, 0.0013239669443192322,
+0.0012336479935763163, 0.0011456632423955128, 0.0010600126907768215, 0.00097740563660531771,
+0.00089784207988100127, 0.00082132202060387221, 0.00074784545877393054, 0.00067741239439117636,
+0.00061026207092162554, 0.00054639448836527808, 0.00048580964672213404, 0.00042850754599219347,
+0.00037448818617545631, 0.00032362096182799095, 0.00027590587294979736, 0.00023134291954087557,
+0.00018993210160122556, 0.00015167341913084733, 0.00011355086773553566, 7.556444741529055e-05,
+3.7714158170111989e-05,
+};
+
+static const snd_filter_t filter_48000_q0[601] = {
+1.0198620188731444, 1.020010340024943, 1.0200400042553026, 1.0200668063441942,
+1.020090746291618, 1.0201118240975737, 1.0201300397620614, 1.020145393285081,
+1.0201602880613769, 1.0201747240909493, 1.020188701373798, 1.020202219909923,
+1.0202152796993242, 1.0202265526819525, 1.0202360388578076, 1.0202437382268896,
+1.0202496507891987, 1.0202537765447348, 1.0202543575152268, 1.0202513937006743,
+1.0202448851010777, 1.0202348317164369, 1.020221233546752, 1.020201978631126,
+1.0201770669695591, 1.0201464985620514, 1.0201102734086027, 1.020068391509213,
+1.0200185436462283, 1.0199607298196485, 1.0198949500294734, 1.0198212042757031,
+1.0197394925583376, 1.0196475393115747, 1.0195453445354141, 1.0194329082298559,
+1.0193102303949002, 1.0191773110305469, 1.0190322090246289, 1.018874924377146,
+1.0187054570880982, 1.0185238071574858, 1.0183299745853085, 1.0181226909094794,
+1.0179019561299987, 1.0176677702468662, 1.0174201332600821, 1.0171590451696462,
+1.0168842554163788, 1.0165957640002801, 1.0162935709213499, 1.0159776761795882,
+1.0156480797749952, 1.015305853524723, 1.0149509974287718, 1.0145835114871415,
+1.0142033956998324, 1.0138106500668442, 1.0134078946530336, 1.0129951294584005,
+1.012572354482945, 1.0121395697266671, 1.0116967751895667, 1.0112482281284423,
+1.0107939285432939, 1.0103338764341214, 1.009868071800925, 1.0093965146437045,
+1.0089250231226645, 1.0084535972378053, 1.0079822369891267, 1.0075109423766286,
+1.0070397134003113, 1.0065756456257706, 1.0061187390530064, 1.0056689936820189,
+1.0052264095128081, 1.0047909865453737, 1.0043706151012313, 1.0039652951803806,
+1.0035750267828216, 1.0031998099085544, 1.0028396445575789, 1.0025025412658284,
+1.0021885000333028, 1.0018975208600021, 1.0016296037459262, 1.0013847486910754,
+1.0011702724829843, 1.0009861751216529, 1.000832456607081, 1.0007091169392688,
+1.0006161561182163, 1.0005592984933067, 1.00053854406454, 1.0005538928319162,
+1.0006053447954353, 1.0006928999550972, 1.0008197977152631, 1.000986038075933,
+1.0011916210371068, 1.0014365465987844, 1.0017208147609662, 1.0020443919998965,
+1.0024072783155753, 1.0028094737080027, 1.0032509781771786, 1.003731791723103,
+1.0042480555948534, 1.00479976979243, 1.0053869343158326, 1.0060095491650611,
+1.0066676143401156, 1.0073531974340806, 1.0080662984469557, 1.0088069173787411,
+1.0095750542294366, 1.0103707089990424, 1.0111820193544871, 1.0120089852957708,
+1.0128516068228934, 1.0137098839358551, 1.0145838166346557, 1.0154581881195079,
+1.0163329983904117, 1.0172082474473672, 1.0180839352903741, 1.0189600619194328,
+1.0198191242862007, 1.0206611223906779, 1.0214860562328643, 1.0222939258127597,
+1.0230847311303644, 1.0238400857727266, 1.0245599897398465, 1.025244443031724,
+1.025893445648359, 1.0265069975897516, 1.0270675974687631, 1.0275752452853937,
+1.0280299410396432, 1.0284316847315116, 1.0287804763609991, 1.029061626190662,
+1.0292751342205002, 1.029421000450514, 1.0294992248807031, 1.0295098075110678,
+1.0294427688556629, 1.0292981089144884, 1.0290758276875442, 1.0287759251748305,
+1.0283984013763472, 1.0279397141845104, 1.02739986359932, 1.0267788496207761,
+1.0260766722488786, 1.0252933314836274, 1.0244330043323175, 1.0234956907949488,
+1.0224813908715213, 1.0213901045620351, 1.02022183186649, 1.0189891748339803,
+1.0176921334645064, 1.0163307077580679, 1.0149048977146651, 1.0134147033342977,
+1.0118810799766345, 1.010304027641675, 1.0086835463294195, 1.0070196360398678,
+1.0053122967730199, 1.0035899337079888, 1.0018525468447743, 1.0001001361833763,
+0.99833270172379518, 0.99655024346603061, 0.99478682663316065, 0.99304245122518531,
+0.9913171172421047, 0.9896108246839187, 0.98792357355062743, 0.9862925053692122,
+0.98471762013967312, 0.98319891786201008, 0.98173639853622319, 0.98033006216231233,
+0.97901687398892545, 0.97779683401606254, 0.97666994224372361, 0.97563619867190865,
+0.97469560330061755, 0.97388127328936347, 0.97319320863814629, 0.97263140934696612,
+0.97219587541582286, 0.97188660684471651, 0.97172905459803127, 0.97172321867576716,
+0.97186909907792418, 0.97216669580450221, 0.97261600885550137, 0.97323121983164651,
+0.97401232873293753, 0.97495933555937453, 0.97607224031095741, 0.97735104298768627,
+0.97879559400491956, 0.98040589336265738, 0.98218194106089973, 0.98412373709964651,
+0.98623128147889783, 0.98848793268555191, 0.99089369071960876, 0.99344855558106837,
+0.99615252726993064, 0.99900560578619568, 1.001973645163257, 1.0050566454011147,
+1.0082546064997686, 1.0115675284592187, 1.0149954112794652, 1.0184869764133027,
+1.0220422238607307, 1.0256611536217497, 1.0293437656963595, 1.0330900600845603,
+1.0368334450498615, 1.0405739205922635, 1.044311486711766, 1.048046143408369,
+1.0517778906820725, 1.0554280763345696, 1.0589967003658602, 1.0624837627759445,
+1.0658892635648223, 1.0692132027324937, 1.0723693843014386, 1.0753578082716571,
+1.0781784746431489, 1.0808313834159142, 1.0833165345899529, 1.085545707986155,
+1.0875189036045203, 1.0892361214450488, 1.0906973615077404, 1.0919026237925953,
+1.0927677784822047, 1.0932928255765688, 1.0934777650756875, 1.0933225969795608,
+1.0928273212881887, 1.0919181695934796, 1.0905951418954336, 1.0888582381940506,
+1.0867074584893306, 1.0841428027812736, 1.0811067927396769, 1.0775994283645405,
+1.0736207096558643, 1.0691706366136484, 1.0642492092378928, 1.0588203361592972,
+1.0528840173778615, 1.0464402528935857, 1.0394890427064698, 1.0320303868165139,
+1.0240533890727215, 1.0155580494750924, 1.006544368023627, 0.99701234471832501,
+0.98696197955918641, 0.97640977439903698, 0.96535572923787671, 0.95379984407570562,
+0.94174211891252368, 0.92918255374833092, 0.91616536337294496, 0.90269054778636582,
+0.88875810698859348, 0.87436804097962795, 0.85952034975946923, 0.844285353454723,
+0.82866305206538915, 0.81265344559146779, 0.79625653403295893, 0.77947231738986256,
+0.76239371780371079, 0.74502073527450363, 0.72735336980224108, 0.70939162138692313,
+0.69113549002854979, 0.67269536204855185, 0.65407123744692919, 0.63526311622368192,
+0.61627099837880994, 0.59709488391231336, 0.5778561801109825, 0.55855488697481748,
+0.53919100450381829, 0.51976453269798495, 0.50027547155731744, 0.4808489997514841,
+0.46148511728048497, 0.44218382414432, 0.4229451203429892, 0.40376900587649256,
+0.38477688803162058, 0.36596876680837326, 0.3473446422067506, 0.3289045142267526,
+0.31064838286837926, 0.29268663445306131, 0.27501926898079876, 0.2576462864515916,
+0.24056768686543983, 0.22378347022234346, 0.20738655866383462, 0.1913769521899133,
+0.1757546508005795, 0.16051965449583325, 0.1456719632756745, 0.13128189726670897,
+0.11734945646893664, 0.10387464088235751, 0.090857450506971582, 0.078297885342778858,
+0.066240160179596969, 0.054684275017425898, 0.043630229856265662, 0.033078024696116246,
+0.023027659536977659, 0.013495636231675615, 0.0044819547802101168, -0.0040133848174188375,
+-0.011990382561211248, -0.019449038451167116, -0.026400248638282928, -0.032844013122558684,
+-0.038780331903994388, -0.044209204982590032, -0.049130632358345624, -0.053580705400561507,
+-0.057559424109237686, -0.061066788484374156, -0.064102798525970922, -0.066667454234027979,
+-0.068818233938748058, -0.07055513764013116, -0.071878165338177272, -0.072787317032886406,
+-0.07328259272425855, -0.073437760820385292, -0.07325282132126662, -0.072727774226902533,
+-0.071862619537293032, -0.07065735725243813, -0.069196117189746442, -0.067478899349217983,
+-0.065505703730852738, -0.063276530334650721, -0.060791379160611919, -0.058138470387846593,
+-0.055317804016354728, -0.052329380046136333, -0.049173198477191406, -0.045849259309519948,
+-0.042443758520642062, -0.038956696110557756, -0.035388072079267023, -0.031737886426769869,
+-0.028006139153066292, -0.02427148245646327, -0.020533916336960809, -0.016793440794558905,
+-0.013050055829257562, -0.0093037614410567751, -0.005621149366446857, -0.0020022196054278077,
+0.0015530278420003733, 0.0050445929758376855, 0.0084724757960841293, 0.011785397755534294,
+0.014983358854188182, 0.018066359092045792, 0.021034398469107124, 0.023887476985372177,
+0.026591448674234484, 0.029146313535694045, 0.031552071569750859, 0.033808722776404926,
+0.035916267155656247, 0.037858063194403074, 0.039634110892645402, 0.04124441025038323,
+0.042688961267616558, 0.043967763944345387, 0.045080668695928285, 0.046027675522365252,
+0.04680878442365629, 0.047423995399801397, 0.047873308450800574, 0.048170905177378653,
+0.048316785579535636, 0.048310949657271514, 0.048153397410586295, 0.047844128839479978,
+0.047408594908336717, 0.04684679561715651, 0.046158730965939358, 0.045344400954685261,
+0.044403805583394219, 0.043370062011579225, 0.04224317023924027, 0.041023130266377363,
+0.039709942092990495, 0.038303605719079675, 0.036841086393292755, 0.03532238411562974,
+0.033747498886090625, 0.032116430704675417, 0.030429179571384107, 0.02872288701319814,
+0.02699755303011751, 0.025253177622142221, 0.023489760789272271, 0.021707302531507662,
+0.019939868071926423, 0.018187457410528556, 0.016450070547314063, 0.014727707482282941,
+0.013020368215435188, 0.011356457925883537, 0.0097359766136279873, 0.0081589242786685376,
+0.0066253009210051894, 0.0051351065406379419, 0.0037092964972351046, 0.0023478707907966783,
+0.0010508294213226633, -0.00018182761118694097, -0.0013501003067321342, -0.0024413866162185014,
+-0.0034556865396460426, -0.0043930000770147576, -0.0052533272283246469, -0.0060366679935757095,
+-0.0067388453654732144, -0.0073598593440171618, -0.0078997099292075507, -0.0083583971210443812,
+-0.0087359209195276549, -0.0090358234322413487, -0.0092581046591854628, -0.009402764600359997,
+-0.0094698032557649497, -0.0094592206254003226, -0.0093809961952111293, -0.0092351299651973699,
+-0.0090216219353590442, -0.0087404721056961523, -0.0083916804762086961, -0.0079899367843402277,
+-0.0075352410300907457, -0.0070275932134602525, -0.0064669933344487472, -0.00585344139305623,
+-0.0052044387764212672, -0.0045199854845438597, -0.0038000815174240071, -0.0030447268750617091,
+-0.0022539215574569659, -0.0014460519775614398, -0.00062111813537513063, 0.00022087996910196154,
+0.0010799423358698369, 0.0019560689649284952, 0.002831756807935534, 0.0037070058648909533,
+0.0045818161357947529, 0.0054561876206469335, 0.0063301203194474943, 0.0071883974324091025,
+0.008031018959531757, 0.0088579849008154597, 0.0096692952562602089, 0.010464950025866004,
+0.011233086876561564, 0.011973705808346887, 0.012686806821221974, 0.013372389915186824,
+0.014030455090241437, 0.014653069939470026, 0.015240234462872589, 0.01579194866044913,
+0.016308212532199644, 0.016789026078124134, 0.017230530547300067, 0.017632725939727444,
+0.017995612255406267, 0.018319189494336533, 0.018603457656518243, 0.018848383218195989,
+0.019053966179369771, 0.019220206540039586, 0.019347104300205437, 0.019434659459867325,
+0.019486111423386358, 0.019501460190762532, 0.019480705761995849, 0.019423848137086312,
+0.019330887316033916, 0.019207547648221818, 0.019053829133650019, 0.018869731772318519,
+0.018655255564227317, 0.018410400509376413, 0.018142483395300606, 0.017851504221999895,
+0.01753746298947428, 0.017200359697723763, 0.016840194346748341, 0.016464977472481143,
+0.016074709074922172, 0.015669389154071425, 0.015249017709928902, 0.014813594742494605,
+0.014371010573283698, 0.013921265202296182, 0.013464358629532054, 0.013000290854991317,
+0.01252906187867397, 0.012057767266175981, 0.011586407017497352, 0.011114981132638084,
+0.010643489611598174, 0.010171932454377624, 0.0097061278211811198, 0.0092460757120086615,
+0.0087917761268602509, 0.0083432290657358861, 0.0079004345286355672, 0.0074676497723576551,
+0.0070448747969021515, 0.0066321096022690556, 0.0062293541884583673, 0.0058366085554700875,
+0.0054564927681608564, 0.0050890068265306747, 0.0047341507305795425, 0.0043919244803074589,
+0.0040623280757144248, 0.003746433333952822, 0.0034442402550226496, 0.0031557488389239081,
+0.002880959085656597, 0.0026198709952207169, 0.00237223400843655, 0.0021380481253040961,
+0.0019173133458233553, 0.0017100296699943279, 0.0015161970978170138, 0.0013345471672045037,
+0.0011650798781567976, 0.0010077952306738957, 0.00086269322475579784, 0.00072977386040250409,
+0.00060709602544678932, 0.00049465971988865362, 0.000392464943728097, 0.00030051169696511946,
+0.00021879997959972099, 0.00014505422582947666, 7.9274435654386481e-05, 2.1460609074450456e-05,
+-2.8387253910331424e-05, -7.0269153299959154e-05, -0.00010649430674866472, -0.00013706271425644812,
+-0.00016197437582330935, -0.00018122929144924842, -0.00019482746113426533, -0.00020488084577506286,
+-0.00021138944537164099, -0.00021435325992399972, -0.00021377228943213908, -0.00020964653389605903,
+-0.00020373397158695203, -0.00019603460250481808, -0.00018654842664965718, -0.00017527544402146932,
+-0.00016221565462025452, -0.00014869711849534485, -0.00013471983564674033, -0.00012028380607444093,
+-0.00010538902977844669, -9.0035506758757598e-05, -7.1819842271068373e-05, -5.0742036315379031e-05,
+-2.6802088891689574e-05,
+};
+
+static const struct {
+  int playback_freq;
+  int pokey_frq;
+  int quality;
+  int size;
+  const snd_filter_t *data;
+} precomputed_filters[] =
+{
+  {22050, 1786050, 0, (int) (sizeof(filter_22050_q0) / sizeof(snd_filter_t)), filter_22050_q0},
+  {31440, 1792080, 0, (int) (sizeof(filter_31440_q0) / sizeof(snd_filter_t)), filter_31440_q0},
+  {44100, 1808100, 0, (int) (sizeof(filter_44100_q0) / sizeof(snd_filter_t)), filter_44100_q0},
+  {48000, 1776000, 0, (int) (sizeof(filter_48000_q0) / sizeof(snd_filter_t)), filter_48000_q0},
+};
+
+#endif /* MZPOKEYSND_FILTERS_H_ */
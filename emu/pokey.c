@@ -229,6 +229,21 @@ static int POKEY_siocheck(void)
 #define Update_pokey_sound(addr, val, chip, gain)
 #endif
 
+/* Registers whose writes only update state derived from the value written,
+   so that rewriting the current value has no effect: AUDFx, AUDCx and
+   AUDCTL of each chip */
+#define ELIDABLE_REGS 0x01ff01ffUL
+
+/* Last value written to each of the above registers */
+static UWORD write_shadow[32];
+
+static void reset_write_shadow(void)
+{
+	int i;
+	for (i = 0; i < 32; i++)
+		write_shadow[i] = WRITE_SHADOW_INVALID;
+}
+
 void POKEY_PutByte(UWORD addr, UBYTE byte)
 {
 #ifdef STEREO_SOUND
@@ -236,6 +251,14 @@ void POKEY_PutByte(UWORD addr, UBYTE byte)
 #else
 	addr &= 0x0f;
 #endif
+	REGISTER_STAT_INC(pokey_write_stat, addr);
+	if (write_shadow[addr] == byte) {
+		REGISTER_STAT_INC(pokey_elided_write_stat, addr);
+		return;
+	}
+	if ((ELIDABLE_REGS >> addr) & 1)
+		write_shadow[addr] = byte;
+
 	switch (addr) {
 	case OFFSET_AUDC1:
 		AUDC[CHAN1] = byte;
@@ -389,6 +412,7 @@ void POKEY_Initialise(void)
 	SKSTAT = 0xef;
 	SKCTLS = 0x00;
 
+	reset_write_shadow();
 	for (i = 0; i < (MAXPOKEYS * 4); i++) {
 		AUDC[i] = 0;
 		AUDF[i] = 0;
@@ -433,6 +457,12 @@ void POKEY_Frame(void)
 
 void POKEY_Scanline(void)
 {
+#ifdef SYNCHRONIZED_SOUND
+	/* Generate the samples of each line as it is emulated, rather
+	   than those of the whole frame at its end */
+	POKEYSND_UpdateSync();
+#endif
+
 	if (pot_scanline < 228)
 		pot_scanline++;
   
@@ -481,6 +511,25 @@ void POKEY_Scanline(void)
 	}
 }
 
+void POKEY_ReplaySoundRegisters(void (*update)(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain))
+{
+	int i;
+
+	update(OFFSET_AUDCTL, AUDCTL[0], 0, SOUND_GAIN);
+	for (i = 0; i < 4; i++) {
+		update((UWORD) (OFFSET_AUDF1 + i * 2), AUDF[i], 0, SOUND_GAIN);
+		update((UWORD) (OFFSET_AUDC1 + i * 2), AUDC[i], 0, SOUND_GAIN);
+	}
+	update(OFFSET_SKCTL, SKCTLS, 0, SOUND_GAIN);
+}
+
+void POKEY_RestoreSound(void)
+{
+	/* The engine has lost the values held in the write shadow */
+	reset_write_shadow();
+	POKEY_ReplaySoundRegisters(POKEYSND_Update);
+}
+
 void POKEYStateSave(void)
 {
 	int SHIFT_KEY = 0;
@@ -488,6 +537,11 @@ void POKEYStateSave(void)
 	UWORD random_scanline_counter_lo;
 	UWORD random_scanline_counter_hi;
 
+#ifdef POKEYSND_THREAD
+	/* Queued writes must reach the sound engine first */
+	POKEYSND_Flush();
+#endif
+
 	SaveUBYTE(&KBCODE, 1);
 	SaveUBYTE(&IRQST, 1);
 	SaveUBYTE(&IRQEN, 1);
@@ -526,6 +580,11 @@ void POKEYStateRead(void)
 	UWORD random_scanline_counter_lo = 0;
 	UWORD random_scanline_counter_hi = 0;
 
+#ifdef POKEYSND_THREAD
+	/* Queued writes must reach the sound engine first */
+	POKEYSND_Flush();
+#endif
+
 	ReadUBYTE(&KBCODE, 1);
 	ReadUBYTE(&IRQST, 1);
 	ReadUBYTE(&IRQEN, 1);
@@ -540,6 +599,7 @@ void POKEYStateRead(void)
 	ReadUBYTE(&AUDF[0], 4);
 	ReadUBYTE(&AUDC[0], 4);
 	ReadUBYTE(&AUDCTL[0], 1);
+	reset_write_shadow();
 	for (i = 0; i < 4; i++) {
 		POKEY_PutByte((UWORD) (OFFSET_AUDF1 + i * 2), AUDF[i]);
 		POKEY_PutByte((UWORD) (OFFSET_AUDC1 + i * 2), AUDC[i]);
@@ -56,6 +56,11 @@ void POKEY_Frame(void);
 void POKEY_Scanline(void);
 void POKEY_StateSave(void);
 void POKEY_StateRead(void);
+/* Passes the audio registers to a newly initialised sound engine. */
+void POKEY_RestoreSound(void);
+/* Calls update (e.g. POKEYSND_Update) with the value of each audio
+   register, as written by POKEY_PutByte(). */
+void POKEY_ReplaySoundRegisters(void (*update)(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain));
 
 /* CONSTANT DEFINITIONS */
 
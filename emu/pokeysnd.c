@@ -23,11 +23,17 @@
 */
 
 #include "config.h"
+#include <retro_inline.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "mzpokeysnd.h"
 #include "pokeysnd.h"
+#ifdef POKEYSND_THREAD
+#include <pthread.h>
+#include <sched.h>
+#endif
 #if defined(PBI_XLD) || defined (VOICEBOX)
 #include "votraxsnd.h"
 #endif
@@ -35,6 +41,11 @@
 #include "gtia.h"
 #include "util.h"
 
+/* M_PI was not defined in MSVC headers */
+#ifndef M_PI
+# define M_PI 3.141592653589793
+#endif
+
 #ifdef WORDS_UNALIGNED_OK
 #  define READ_U32(x)     (*(uint32_t *) (x))
 #  define WRITE_U32(x, d) (*(uint32_t *) (x) = (d))
@@ -133,6 +144,7 @@ int POKEYSND_snd_flags = 0;
 static int mz_quality = 0;		/* default quality for mzpokeysnd */
 
 int POKEYSND_enable_new_pokey = TRUE;
+int POKEYSND_band_limited = FALSE;
 int POKEYSND_bienias_fix = TRUE;  /* when TRUE, high frequencies get emulated: better sound but slower */
 #if defined(__PLUS) && !defined(_WX_)
 #define BIENIAS_FIX (g_Sound.nBieniasFix)
@@ -144,9 +156,14 @@ int POKEYSND_stereo_enabled = FALSE;
 
 int POKEYSND_volume = 0x100;
 
+int POKEYSND_lowpass_factor = 0;
+int POKEYSND_lowpass_prev = 0;
+
 /* multiple sound engine interface */
 static void pokeysnd_process_8(void *sndbuffer, int sndn);
 static void pokeysnd_process_16(void *sndbuffer, int sndn);
+static void pokeysnd_process_16_stereo(void *sndbuffer, int sndn);
+static void pokeysnd_process_blep(void *sndbuffer, int sndn);
 static void null_pokey_process(void *sndbuffer, int sndn) {}
 void (*POKEYSND_Process_ptr)(void *sndbuffer, int sndn) = null_pokey_process;
 
@@ -179,6 +196,7 @@ UBYTE *POKEYSND_process_buffer = NULL;
 unsigned int POKEYSND_process_buffer_length;
 unsigned int POKEYSND_process_buffer_fill;
 static unsigned int prev_update_tick;
+double POKEYSND_frame_rate = FPS_NTSC;
 
 static void Generate_sync_rf(unsigned int num_ticks);
 static void null_generate_sync(unsigned int num_ticks) {}
@@ -216,6 +234,49 @@ static int const CONSOLE_VOL = 32;
 /* number only.                                                              */
 /*****************************************************************************/
 
+#ifdef WORDS_BIGENDIAN
+#define SAMP_N_CNT_WHOLE ((UBYTE *) (&Samp_n_cnt[0]) + 3)
+#define SAMP_N_CNT_FIXED Samp_n_cnt[1]
+#else
+#define SAMP_N_CNT_WHOLE ((UBYTE *) (&Samp_n_cnt[0]) + 1)
+#define SAMP_N_CNT_FIXED Samp_n_cnt[0]
+#endif
+
+/*****************************************************************************/
+/* Band-limited step synthesis (POKEYSND_band_limited)                       */
+/*                                                                           */
+/* Sampling the output of the channels aliases every frequency above half    */
+/* the playback frequency. Instead, each change of the output is added to    */
+/* the samples around it as a band-limited step: the integral of a windowed  */
+/* sinc, precomputed for BLEP_PHASES positions between two samples. The      */
+/* steps are stored as the differences between consecutive samples, so a     */
+/* change costs BLEP_TAPS additions, and the output is their running sum,    */
+/* delayed by BLEP_HALF_WIDTH samples.                                       */
+/*****************************************************************************/
+
+#ifndef BLEP_HALF_WIDTH
+#define BLEP_HALF_WIDTH 12
+#endif
+#define BLEP_TAPS (2 * BLEP_HALF_WIDTH + 1)
+#define BLEP_PHASES 64
+/* Cutoff frequency, as a fraction of the playback frequency */
+#ifndef BLEP_CUTOFF
+#define BLEP_CUTOFF 0.38
+#endif
+/* Fixed point precision of the steps */
+#define BLEP_SHIFT 15
+/* Number of samples output before the pending differences are moved back
+   to the start of the buffer */
+#define BLEP_BUFFER_SIZE 64
+
+static int blep_table[BLEP_PHASES + 1][BLEP_TAPS];
+static int blep_table_ready = FALSE;
+static int blep_buffer[BLEP_BUFFER_SIZE + BLEP_TAPS];
+static unsigned int blep_pos;		/* buffer index of the next sample */
+static int blep_sum;				/* running sum, << BLEP_SHIFT */
+static int blep_level;				/* level all steps so far lead to */
+static uint32_t blep_phase_mult;	/* converts Samp_n_cnt to a phase, 16.16 */
+
 
 /*****************************************************************************/
 /* Module:  pokeysnd_init_rf()                                              */
@@ -254,12 +315,42 @@ void Pokey_sound_init(uint32_t freq17, UWORD playback_freq, UBYTE num_pokeys, un
 {
 	//SndSave_CloseSoundFile();
 
+#ifdef POKEYSND_THREAD
+	/* The engine may only be initialised while the worker is idle */
+	POKEYSND_Flush();
+#endif /* POKEYSND_THREAD */
+
 	init_vol_only();
 
+	POKEYSND_playback_freq = playback_freq;
+	POKEYSND_num_pokeys = num_pokeys;
+	POKEYSND_snd_flags = flags;
+#ifdef SYNCHRONIZED_SOUND
+	{
+		/* A single call to Atari800_Frame may emulate a bit more CPU ticks than the exact number of
+		   ticks per frame (tv_mode*114). So we add a line of ticks to buffer size just to be safe. */
+		unsigned int const surplus_ticks = 114;
+		double samples_per_frame = (double)playback_freq/POKEYSND_frame_rate;
+		unsigned int ticks_per_frame = tv_mode*114;
+		unsigned int max_ticks_per_frame = ticks_per_frame + surplus_ticks;
+		double ticks_per_sample = (double)ticks_per_frame / samples_per_frame;
+		POKEYSND_process_buffer_length = num_pokeys * (unsigned int)ceil((double)max_ticks_per_frame / ticks_per_sample) * POKEYSND_SAMPLE_SIZE(flags);
+		free(POKEYSND_process_buffer);
+		POKEYSND_process_buffer = (UBYTE *)Util_malloc(POKEYSND_process_buffer_length);
+		POKEYSND_process_buffer_fill = 0;
+		prev_update_tick = cpu_clock;
+	}
+#endif /* SYNCHRONIZED_SOUND */
+
 	if (POKEYSND_enable_new_pokey)
 		MZPOKEYSND_Init(freq17, playback_freq, num_pokeys, flags, mz_quality);
 	else
 		pokeysnd_init_rf(freq17, playback_freq, num_pokeys, flags);
+
+#ifdef POKEYSND_THREAD
+	if (POKEYSND_GenerateSync == Generate_sync_rf)
+		POKEYSND_StopThread();
+#endif /* POKEYSND_THREAD */
 }
 
 #if 0
@@ -312,17 +403,202 @@ void Pokey_process(void *sndbuffer, int sndn)
 }
 
 #ifdef SYNCHRONIZED_SOUND
+/* Generates the samples up to CPU cycle 'tick' */
+static void Generate_synchronized_sound(unsigned int tick)
+{
+	unsigned int ticks = tick - prev_update_tick;
+
+	/* cpu_clock steps back slightly when xpos is restored from a state */
+	if ((int) ticks > 0)
+		POKEYSND_GenerateSync(ticks);
+	prev_update_tick = tick;
+}
+
 static void Update_synchronized_sound(void)
 {
-	POKEYSND_GenerateSync(cpu_clock - prev_update_tick);
-	prev_update_tick = cpu_clock;
+	Generate_synchronized_sound(cpu_clock);
+}
+#endif /* SYNCHRONIZED_SOUND */
+
+#ifdef POKEYSND_THREAD
+/* Threaded synthesis: the emulation thread queues each register write
+   (and each catch-up) with the CPU cycle it happened at, and the worker
+   thread replays the queue - so the output is identical to that of the
+   unthreaded synchronized sound. The queue is a single producer/single
+   consumer ring, whose indices are free-running: each is only written
+   by one of the two threads. */
+
+/* Must be a power of 2. A frame queues a catch-up per scanline, plus the
+   register writes; the producer waits for the worker if it is full */
+#define THREAD_QUEUE_SIZE 4096
+#define THREAD_QUEUE_MASK (THREAD_QUEUE_SIZE - 1)
+/* 'addr' of a catch-up, which generates samples but writes no register */
+#define THREAD_SYNC 0xffff
+/* Number of times an idle worker yields before it sleeps */
+#define THREAD_SPIN_COUNT 256
+
+typedef struct {
+	unsigned int tick;
+	UWORD addr;
+	UBYTE val;
+	UBYTE chip;
+	UBYTE gain;
+} thread_event;
+
+static thread_event thread_queue[THREAD_QUEUE_SIZE];
+static unsigned int thread_queue_write;	/* written by the emulation thread */
+static unsigned int thread_queue_read;	/* written by the worker */
+static int thread_sleeping;
+static int thread_quit;
+static int thread_running = FALSE;
+static pthread_t thread_handle;
+static pthread_mutex_t thread_mutex;
+static pthread_cond_t thread_cond;
+
+static void *thread_loop(void *arg)
+{
+	unsigned int read = thread_queue_read;
+	int idle = 0;
+
+	for (;;) {
+		if (read != __atomic_load_n(&thread_queue_write, __ATOMIC_ACQUIRE)) {
+			const thread_event *ev = &thread_queue[read & THREAD_QUEUE_MASK];
+
+			Generate_synchronized_sound(ev->tick);
+			if (ev->addr != THREAD_SYNC)
+				POKEYSND_Update_ptr(ev->addr, ev->val, ev->chip, ev->gain);
+			/* The event is only released once it has been processed, so
+			   an empty queue means the engine is idle */
+			__atomic_store_n(&thread_queue_read, ++read, __ATOMIC_RELEASE);
+			idle = 0;
+			continue;
+		}
+
+		if (++idle < THREAD_SPIN_COUNT) {
+			sched_yield();
+			continue;
+		}
+
+		/* Sleep until the next event. thread_sleeping and
+		   thread_queue_write are written and then read in opposite
+		   orders by the two threads, so either the producer sees the
+		   worker sleeping, or the worker sees the new event */
+		pthread_mutex_lock(&thread_mutex);
+		__atomic_store_n(&thread_sleeping, TRUE, __ATOMIC_SEQ_CST);
+		while (read == __atomic_load_n(&thread_queue_write, __ATOMIC_SEQ_CST) && !thread_quit)
+			pthread_cond_wait(&thread_cond, &thread_mutex);
+		__atomic_store_n(&thread_sleeping, FALSE, __ATOMIC_SEQ_CST);
+		if (thread_quit && read == __atomic_load_n(&thread_queue_write, __ATOMIC_ACQUIRE)) {
+			pthread_mutex_unlock(&thread_mutex);
+			break;
+		}
+		pthread_mutex_unlock(&thread_mutex);
+		idle = 0;
+	}
+
+	return NULL;
+}
+
+static void thread_put(unsigned int tick, UWORD addr, UBYTE val, UBYTE chip, UBYTE gain)
+{
+	unsigned int write = thread_queue_write;
+	thread_event *ev;
+
+	while (write - __atomic_load_n(&thread_queue_read, __ATOMIC_ACQUIRE) >= THREAD_QUEUE_SIZE)
+		sched_yield();
+
+	ev = &thread_queue[write & THREAD_QUEUE_MASK];
+	ev->tick = tick;
+	ev->addr = addr;
+	ev->val = val;
+	ev->chip = chip;
+	ev->gain = gain;
+	__atomic_store_n(&thread_queue_write, write + 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&thread_sleeping, __ATOMIC_SEQ_CST)) {
+		pthread_mutex_lock(&thread_mutex);
+		pthread_cond_signal(&thread_cond);
+		pthread_mutex_unlock(&thread_mutex);
+	}
+}
+
+void POKEYSND_Flush(void)
+{
+	if (!thread_running)
+		return;
+	while (__atomic_load_n(&thread_queue_read, __ATOMIC_ACQUIRE) != thread_queue_write)
+		sched_yield();
+}
+
+int POKEYSND_StartThread(void)
+{
+	if (thread_running)
+		return TRUE;
+	/* The rf engine reads the POKEY registers, which the emulation thread
+	   may have changed since the write was queued */
+	if (POKEYSND_GenerateSync == Generate_sync_rf)
+		return FALSE;
+
+	thread_queue_write = 0;
+	thread_queue_read = 0;
+	thread_sleeping = FALSE;
+	thread_quit = FALSE;
+	pthread_mutex_init(&thread_mutex, NULL);
+	pthread_cond_init(&thread_cond, NULL);
+
+	if (pthread_create(&thread_handle, NULL, thread_loop, NULL) != 0) {
+		pthread_cond_destroy(&thread_cond);
+		pthread_mutex_destroy(&thread_mutex);
+		return FALSE;
+	}
+
+	thread_running = TRUE;
+	return TRUE;
+}
+
+void POKEYSND_StopThread(void)
+{
+	if (!thread_running)
+		return;
+
+	pthread_mutex_lock(&thread_mutex);
+	thread_quit = TRUE;
+	pthread_cond_signal(&thread_cond);
+	pthread_mutex_unlock(&thread_mutex);
+	pthread_join(thread_handle, NULL);
+
+	pthread_cond_destroy(&thread_cond);
+	pthread_mutex_destroy(&thread_mutex);
+	thread_running = FALSE;
+}
+#endif /* POKEYSND_THREAD */
+
+#ifdef SYNCHRONIZED_SOUND
+void POKEYSND_UpdateSync(void)
+{
+#ifdef POKEYSND_THREAD
+	if (thread_running) {
+		thread_put(cpu_clock, THREAD_SYNC, 0, 0, 0);
+		return;
+	}
+#endif /* POKEYSND_THREAD */
+	Update_synchronized_sound();
 }
 
 int POKEYSND_UpdateProcessBuffer(void)
 {
 	int sndn;
+#ifdef POKEYSND_THREAD
+	if (thread_running) {
+		/* The worker only writes the process buffer while processing
+		   events, so it may be read once the queue is empty */
+		thread_put(cpu_clock, THREAD_SYNC, 0, 0, 0);
+		POKEYSND_Flush();
+	}
+	else
+#endif /* POKEYSND_THREAD */
 	Update_synchronized_sound();
-	sndn = POKEYSND_process_buffer_fill / ((POKEYSND_snd_flags & POKEYSND_BIT16) ? 2 : 1);
+	sndn = POKEYSND_process_buffer_fill / POKEYSND_SAMPLE_SIZE(POKEYSND_snd_flags);
 	POKEYSND_process_buffer_fill = 0;
 
 #if defined(PBI_XLD) || defined (VOICEBOX)
@@ -338,7 +614,7 @@ int POKEYSND_UpdateProcessBuffer(void)
 #ifdef SYNCHRONIZED_SOUND
 static void init_syncsound(void)
 {
-	double samples_per_frame = (double)POKEYSND_playback_freq/(tv_mode == TV_PAL ? FPS_PAL : FPS_NTSC);
+	double samples_per_frame = (double)POKEYSND_playback_freq/POKEYSND_frame_rate;
 	unsigned int ticks_per_frame = tv_mode*114;
 	ticks_per_sample = (double)ticks_per_frame / samples_per_frame;
 	samp_pos = 0.0;
@@ -347,6 +623,62 @@ static void init_syncsound(void)
 }
 #endif /* SYNCHRONIZED_SOUND */
 
+/* Precomputes the differences of the band-limited steps */
+static void init_blep_table(void)
+{
+	/* The windowed sinc, sampled BLEP_PHASES times per sample */
+	static double impulse[2 * BLEP_HALF_WIDTH * BLEP_PHASES];
+	int const impulse_size = 2 * BLEP_HALF_WIDTH * BLEP_PHASES;
+	int phase, tap, i;
+
+	for (i = 0; i < impulse_size; i++) {
+		double x = (i + 0.5) / BLEP_PHASES - BLEP_HALF_WIDTH;
+		double t = M_PI * x / BLEP_HALF_WIDTH;
+		double window = 0.42 + 0.5 * cos(t) + 0.08 * cos(2.0 * t);	/* Blackman */
+		double arg = 2.0 * M_PI * BLEP_CUTOFF * x;
+		impulse[i] = sin(arg) / arg * window;
+	}
+
+	/* In phase p, the step occurs p/BLEP_PHASES of a sample before the
+	   sample in tap 0 (so tap BLEP_HALF_WIDTH is at its centre). Each tap
+	   is the integral of the impulse since the previous tap. */
+	for (phase = 0; phase <= BLEP_PHASES; phase++) {
+		double taps[BLEP_TAPS];
+		double sum = 0.0;
+		int total = 0;
+		int peak = 0;
+
+		for (tap = 0; tap < BLEP_TAPS; tap++) {
+			int start = (tap - 1) * BLEP_PHASES + phase;
+			taps[tap] = 0.0;
+			for (i = start < 0 ? 0 : start; i < start + BLEP_PHASES && i < impulse_size; i++)
+				taps[tap] += impulse[i];
+			sum += taps[tap];
+		}
+		for (tap = 0; tap < BLEP_TAPS; tap++) {
+			blep_table[phase][tap] = (int) floor(taps[tap] / sum * (1 << BLEP_SHIFT) + 0.5);
+			total += blep_table[phase][tap];
+			if (blep_table[phase][tap] > blep_table[phase][peak])
+				peak = tap;
+		}
+		/* so every step adds exactly its size to the running sum */
+		blep_table[phase][peak] += (1 << BLEP_SHIFT) - total;
+	}
+	blep_table_ready = TRUE;
+}
+
+static void init_blep(void)
+{
+	if (!blep_table_ready)
+		init_blep_table();
+
+	memset(blep_buffer, 0, sizeof(blep_buffer));
+	blep_pos = 0;
+	blep_level = POKEYSND_SAMP_MIN;
+	blep_sum = POKEYSND_SAMP_MIN * (1 << BLEP_SHIFT);
+	blep_phase_mult = ((uint32_t) BLEP_PHASES << 16) / Samp_n_max;
+}
+
 static int pokeysnd_init_rf(uint32_t freq17, int playback_freq,
            UBYTE num_pokeys, int flags)
 {
@@ -361,7 +693,12 @@ static int pokeysnd_init_rf(uint32_t freq17, int playback_freq,
 #endif
 	POKEYSND_UpdateVolOnly = Update_vol_only_sound_rf;
 
-	POKEYSND_Process_ptr = (flags & POKEYSND_BIT16) ? pokeysnd_process_16 : pokeysnd_process_8;
+	if (POKEYSND_band_limited)
+		POKEYSND_Process_ptr = pokeysnd_process_blep;
+	else if (flags & POKEYSND_BIT16)
+		POKEYSND_Process_ptr = (flags & POKEYSND_STEREO) ? pokeysnd_process_16_stereo : pokeysnd_process_16;
+	else
+		POKEYSND_Process_ptr = pokeysnd_process_8;
 
 	POKEYSND_samp_freq = playback_freq;
 
@@ -377,6 +714,9 @@ static int pokeysnd_init_rf(uint32_t freq17, int playback_freq,
 	Samp_n_cnt[0] = 0;			/* initialize all bits of the sample */
 	Samp_n_cnt[1] = 0;			/* 'divide by N' counter */
 
+	if (POKEYSND_band_limited)
+		init_blep();
+
 	for (chan = 0; chan < (MAXPOKEYS * 4); chan++) {
 		Outvol[chan] = 0;
 		Outbit[chan] = 0;
@@ -415,8 +755,18 @@ static int pokeysnd_init_rf(uint32_t freq17, int playback_freq,
 /*                                                                           */
 /*****************************************************************************/
 
+void (*POKEYSND_trace_hook)(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain) = NULL;
+
 void POKEYSND_Update(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain)
 {
+	if (POKEYSND_trace_hook)
+		POKEYSND_trace_hook(addr, val, chip, gain);
+#ifdef POKEYSND_THREAD
+	if (thread_running) {
+		thread_put(cpu_clock, addr, val, chip, gain);
+		return;
+	}
+#endif /* POKEYSND_THREAD */
 #ifdef SYNCHRONIZED_SOUND
     Update_synchronized_sound();
 #endif /* SYNCHRONIZED_SOUND */
@@ -673,14 +1023,201 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 /*                                                                           */
 /*****************************************************************************/
 
+/* Advances POKEYSND_sampout to the volume-only sample of the next output sample */
+static INLINE void rf_update_vol_only(void)
+{
+	if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr) {
+		int l;
+		if (POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] > 0)
+			POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] -= 1280;
+		while ((l = POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]) <= 0) {
+			POKEYSND_sampout = POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
+			POKEYSND_sampbuf_rptr++;
+			if (POKEYSND_sampbuf_rptr >= POKEYSND_SAMPBUF_MAX)
+				POKEYSND_sampbuf_rptr = 0;
+			if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr)
+				POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] += l;
+			else
+				break;
+		}
+	}
+}
+
+/* Finds the next event: either SAMPLE or the channel whose 'divide by N' */
+/* counter expires first, and the number of ticks until it occurs. */
+static INLINE UBYTE rf_next_event(uint32_t *event_min)
+{
+	uint32_t *div_n_ptr = Div_n_cnt;
+	uint32_t min = READ_U32(SAMP_N_CNT_WHOLE);
+	UBYTE next_event = SAMPLE;
+	UBYTE count = 0;
+
+	do {
+		/* Though I could have used a loop here, this is faster */
+		if (*div_n_ptr <= min) {
+			min = *div_n_ptr;
+			next_event = CHAN1 + (count << 2);
+		}
+		div_n_ptr++;
+		if (*div_n_ptr <= min) {
+			min = *div_n_ptr;
+			next_event = CHAN2 + (count << 2);
+		}
+		div_n_ptr++;
+		if (*div_n_ptr <= min) {
+			min = *div_n_ptr;
+			next_event = CHAN3 + (count << 2);
+		}
+		div_n_ptr++;
+		if (*div_n_ptr <= min) {
+			min = *div_n_ptr;
+			next_event = CHAN4 + (count << 2);
+		}
+		div_n_ptr++;
+
+		count++;
+	} while (count < Num_pokeys);
+
+	*event_min = min;
+	return next_event;
+}
+
+/* Advances all counters by event_min ticks to the channel event next_event, */
+/* and processes it. Returns the change of the output value. */
+static INLINE int rf_channel_event(UBYTE next_event, uint32_t event_min)
+{
+	uint32_t *div_n_ptr = Div_n_cnt;
+	UBYTE *out_ptr;
+	UBYTE audc;
+	UBYTE toggle;
+	UBYTE count;
+	int delta = 0;
+
+	/* shift the polynomial counters */
+
+	count = Num_pokeys;
+	do {
+		/* decrement all counters by the smallest count found */
+		/* again, no loop for efficiency */
+		*div_n_ptr++ -= event_min;
+		*div_n_ptr++ -= event_min;
+		*div_n_ptr++ -= event_min;
+		*div_n_ptr++ -= event_min;
+
+		count--;
+	} while (count);
+
+
+	WRITE_U32(SAMP_N_CNT_WHOLE, READ_U32(SAMP_N_CNT_WHOLE) - event_min);
+
+	/* since the polynomials require a mod (%) function which is
+	   division, I don't adjust the polynomials on the SAMPLE events,
+	   only the CHAN events.  I have to keep track of the change,
+	   though. */
+
+	P4 = (P4 + event_min) % POLY4_SIZE;
+	P5 = (P5 + event_min) % POLY5_SIZE;
+	P9 = (P9 + event_min) % POLY9_SIZE;
+	P17 = (P17 + event_min) % POLY17_SIZE;
+
+	/* adjust channel counter */
+	Div_n_cnt[next_event] += Div_n_max[next_event];
+
+	/* get the current AUDC into a register (for optimization) */
+	audc = AUDC[next_event];
+
+	/* set a pointer to the current output (for opt...) */
+	out_ptr = &Outvol[next_event];
+
+	/* assume no changes to the output */
+	toggle = FALSE;
+
+	/* From here, a good understanding of the hardware is required */
+	/* to understand what is happening.  I won't be able to provide */
+	/* much description to explain it here. */
+
+	/* if VOLUME only then nothing to process */
+	if (!(audc & VOL_ONLY)) {
+		/* if the output is pure or the output is poly5 and the poly5 bit */
+		/* is set */
+		if ((audc & NOTPOLY5) || bit5[P5]) {
+			/* if the PURETONE bit is set */
+			if (audc & PURETONE) {
+				/* then simply toggle the output */
+				toggle = TRUE;
+			}
+			/* otherwise if POLY4 is selected */
+			else if (audc & POLY4) {
+				/* then compare to the poly4 bit */
+				toggle = (bit4[P4] == !(*out_ptr));
+			}
+			else {
+				/* if 9-bit poly is selected on this chip */
+				if (AUDCTL[next_event >> 2] & POLY9) {
+					/* compare to the poly9 bit */
+					toggle = ((poly9_lookup[P9] & 1) == !(*out_ptr));
+				}
+				else {
+					/* otherwise compare to the poly17 bit */
+					toggle = (((poly17_lookup[P17 >> 3] >> (P17 & 7)) & 1) == !(*out_ptr));
+				}
+			}
+		}
+	}
+
+	/* check channel 1 filter (clocked by channel 3) */
+	if ( AUDCTL[next_event >> 2] & CH1_FILTER) {
+		/* if we're processing channel 3 */
+		if ((next_event & 0x03) == CHAN3) {
+			/* check output of channel 1 on same chip */
+			if (Outvol[next_event & 0xfd]) {
+				/* if on, turn it off */
+				Outvol[next_event & 0xfd] = 0;
+				delta -= pokeysnd_AUDV[next_event & 0xfd];
+			}
+		}
+	}
+
+	/* check channel 2 filter (clocked by channel 4) */
+	if ( AUDCTL[next_event >> 2] & CH2_FILTER) {
+		/* if we're processing channel 4 */
+		if ((next_event & 0x03) == CHAN4) {
+			/* check output of channel 2 on same chip */
+			if (Outvol[next_event & 0xfd]) {
+				/* if on, turn it off */
+				Outvol[next_event & 0xfd] = 0;
+				delta -= pokeysnd_AUDV[next_event & 0xfd];
+			}
+		}
+	}
+
+	/* if the current output bit has changed */
+	if (toggle) {
+		if (*out_ptr) {
+			/* remove this channel from the signal */
+			delta -= pokeysnd_AUDV[next_event];
+
+			/* and turn the output off */
+			*out_ptr = 0;
+		}
+		else {
+			/* turn the output on */
+			*out_ptr = 1;
+
+			/* and add it to the output signal */
+			delta += pokeysnd_AUDV[next_event];
+		}
+	}
+
+	return delta;
+}
+
 static void pokeysnd_process_8(void *sndbuffer, int sndn)
 {
 	register UBYTE *buffer = (UBYTE *) sndbuffer;
 	register int n = sndn;
 
-	register uint32_t *div_n_ptr;
-	register UBYTE *samp_cnt_w_ptr;
-	register uint32_t event_min;
+	uint32_t event_min;
 	register UBYTE next_event;
 #ifdef CLIP_SOUND
 	register SWORD cur_val;		/* then we have to count as 16-bit signed */
@@ -694,18 +1231,9 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 #endif
 #endif /* CLIP_SOUND */
 	register UBYTE *out_ptr;
-	register UBYTE audc;
-	register UBYTE toggle;
 	register UBYTE count;
 	register UBYTE *vol_ptr;
 
-	/* set a pointer to the whole portion of the samp_n_cnt */
-#ifdef WORDS_BIGENDIAN
-	samp_cnt_w_ptr = ((UBYTE *) (&Samp_n_cnt[0]) + 3);
-#else
-	samp_cnt_w_ptr = ((UBYTE *) (&Samp_n_cnt[0]) + 1);
-#endif
-
 	/* set a pointer for optimization */
 	out_ptr = Outvol;
 	vol_ptr = pokeysnd_AUDV;
@@ -775,179 +1303,16 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 		/* 'accelerated' time by adjusting all pointers by that amount. */
 
 		/* find next smallest event (either sample or chan 1-4) */
-		next_event = SAMPLE;
-		event_min = READ_U32(samp_cnt_w_ptr);
-
-		div_n_ptr = Div_n_cnt;
-
-		count = 0;
-		do {
-			/* Though I could have used a loop here, this is faster */
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = CHAN1 + (count << 2);
-			}
-			div_n_ptr++;
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = CHAN2 + (count << 2);
-			}
-			div_n_ptr++;
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = CHAN3 + (count << 2);
-			}
-			div_n_ptr++;
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = CHAN4 + (count << 2);
-			}
-			div_n_ptr++;
-
-			count++;
-		} while (count < Num_pokeys);
+		next_event = rf_next_event(&event_min);
 
 		/* if the next event is a channel change */
 		if (next_event != SAMPLE) {
-			/* shift the polynomial counters */
-
-			count = Num_pokeys;
-			do {
-				/* decrement all counters by the smallest count found */
-				/* again, no loop for efficiency */
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-
-				count--;
-			} while (count);
-
-
-			WRITE_U32(samp_cnt_w_ptr, READ_U32(samp_cnt_w_ptr) - event_min);
-
-			/* since the polynomials require a mod (%) function which is
-			   division, I don't adjust the polynomials on the SAMPLE events,
-			   only the CHAN events.  I have to keep track of the change,
-			   though. */
-
-			P4 = (P4 + event_min) % POLY4_SIZE;
-			P5 = (P5 + event_min) % POLY5_SIZE;
-			P9 = (P9 + event_min) % POLY9_SIZE;
-			P17 = (P17 + event_min) % POLY17_SIZE;
-
-			/* adjust channel counter */
-			Div_n_cnt[next_event] += Div_n_max[next_event];
-
-			/* get the current AUDC into a register (for optimization) */
-			audc = AUDC[next_event];
-
-			/* set a pointer to the current output (for opt...) */
-			out_ptr = &Outvol[next_event];
-
-			/* assume no changes to the output */
-			toggle = FALSE;
-
-			/* From here, a good understanding of the hardware is required */
-			/* to understand what is happening.  I won't be able to provide */
-			/* much description to explain it here. */
-
-			/* if VOLUME only then nothing to process */
-			if (!(audc & VOL_ONLY)) {
-				/* if the output is pure or the output is poly5 and the poly5 bit */
-				/* is set */
-				if ((audc & NOTPOLY5) || bit5[P5]) {
-					/* if the PURETONE bit is set */
-					if (audc & PURETONE) {
-						/* then simply toggle the output */
-						toggle = TRUE;
-					}
-					/* otherwise if POLY4 is selected */
-					else if (audc & POLY4) {
-						/* then compare to the poly4 bit */
-						toggle = (bit4[P4] == !(*out_ptr));
-					}
-					else {
-						/* if 9-bit poly is selected on this chip */
-						if (AUDCTL[next_event >> 2] & POLY9) {
-							/* compare to the poly9 bit */
-							toggle = ((poly9_lookup[P9] & 1) == !(*out_ptr));
-						}
-						else {
-							/* otherwise compare to the poly17 bit */
-							toggle = (((poly17_lookup[P17 >> 3] >> (P17 & 7)) & 1) == !(*out_ptr));
-						}
-					}
-				}
-			}
-
-			/* check channel 1 filter (clocked by channel 3) */
-			if ( AUDCTL[next_event >> 2] & CH1_FILTER) {
-				/* if we're processing channel 3 */
-				if ((next_event & 0x03) == CHAN3) {
-					/* check output of channel 1 on same chip */
-					if (Outvol[next_event & 0xfd]) {
-						/* if on, turn it off */
-						Outvol[next_event & 0xfd] = 0;
 #ifdef STEREO_SOUND
-						if ((next_event & 0x04))
-							cur_val2 -= pokeysnd_AUDV[next_event & 0xfd];
-						else
-#endif /* STEREO_SOUND */
-							cur_val -= pokeysnd_AUDV[next_event & 0xfd];
-					}
-				}
-			}
-
-			/* check channel 2 filter (clocked by channel 4) */
-			if ( AUDCTL[next_event >> 2] & CH2_FILTER) {
-				/* if we're processing channel 4 */
-				if ((next_event & 0x03) == CHAN4) {
-					/* check output of channel 2 on same chip */
-					if (Outvol[next_event & 0xfd]) {
-						/* if on, turn it off */
-						Outvol[next_event & 0xfd] = 0;
-#ifdef STEREO_SOUND
-						if ((next_event & 0x04))
-							cur_val2 -= pokeysnd_AUDV[next_event & 0xfd];
-						else
-#endif /* STEREO_SOUND */
-							cur_val -= pokeysnd_AUDV[next_event & 0xfd];
-					}
-				}
-			}
-
-			/* if the current output bit has changed */
-			if (toggle) {
-				if (*out_ptr) {
-					/* remove this channel from the signal */
-#ifdef STEREO_SOUND
-					if ((next_event & 0x04))
-						cur_val2 -= pokeysnd_AUDV[next_event];
-					else
-#endif /* STEREO_SOUND */
-						cur_val -= pokeysnd_AUDV[next_event];
-
-					/* and turn the output off */
-					*out_ptr = 0;
-				}
-				else {
-					/* turn the output on */
-					*out_ptr = 1;
-
-					/* and add it to the output signal */
-#ifdef STEREO_SOUND
-					if ((next_event & 0x04))
-						cur_val2 += pokeysnd_AUDV[next_event];
-					else
+			if ((next_event & 0x04))
+				cur_val2 += rf_channel_event(next_event, event_min);
+			else
 #endif /* STEREO_SOUND */
-						cur_val += pokeysnd_AUDV[next_event];
-				}
-			}
+				cur_val += rf_channel_event(next_event, event_min);
 		}
 		else {					/* otherwise we're processing a sample */
 			/* adjust the sample counter - note we're using the 24.8 integer
@@ -992,21 +1357,7 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 #endif  /* INTERPOLATE_SOUND */
 
 			{
-				if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr) {
-					int l;
-					if (POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] > 0)
-						POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] -= 1280;
-					while ((l = POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]) <= 0) {
-						POKEYSND_sampout = POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
-						POKEYSND_sampbuf_rptr++;
-						if (POKEYSND_sampbuf_rptr >= POKEYSND_SAMPBUF_MAX)
-							POKEYSND_sampbuf_rptr = 0;
-						if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr)
-							POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] += l;
-						else
-							break;
-					}
-				}
+				rf_update_vol_only();
 				iout += POKEYSND_sampout;
 #ifdef STEREO_SOUND
 				{
@@ -1152,6 +1503,124 @@ static void pokeysnd_process_16(void *sndbuffer, int sndn)
 	}
 }
 
+/* The 8-bit samples are generated into the last quarter of the buffer,
+   which the stereo samples only overwrite once they have been read */
+static void pokeysnd_process_16_stereo(void *sndbuffer, int sndn)
+{
+	SWORD *buffer = (SWORD *) sndbuffer;
+	UBYTE *samples = (UBYTE *) sndbuffer + 3 * sndn;
+	int i;
+
+	pokeysnd_process_8(samples, sndn);
+
+	for (i = 0; i < sndn; i++) {
+#ifndef POKEYSND_SIGNED_SAMPLES
+		int smp = ((int) samples[i] - 0x80) * POKEYSND_volume;
+#else
+		int smp = ((int) ((SBYTE *) samples)[i]) * POKEYSND_volume;
+#endif
+
+		POKEYSND_PUT_STEREO16(buffer, smp);
+	}
+}
+
+/* Adds a change of the output by delta, phase/BLEP_PHASES of a sample before
+   the next sample */
+static INLINE void blep_add_step(int delta, unsigned int phase)
+{
+	const int *step = blep_table[phase];
+	int *buffer = blep_buffer + blep_pos;
+	int i;
+
+	for (i = 0; i < BLEP_TAPS; i++)
+		buffer[i] += delta * step[i];
+	blep_level += delta;
+}
+
+/* The phase of a change occuring now */
+static INLINE unsigned int blep_phase(void)
+{
+	unsigned int phase = (SAMP_N_CNT_FIXED * blep_phase_mult + 0x8000) >> 16;
+	return phase > BLEP_PHASES ? BLEP_PHASES : phase;
+}
+
+/* As pokeysnd_process_8(), but the changes of the output are band-limited,
+   and the samples are written in the format of POKEYSND_snd_flags. The
+   output of all chips is mixed. */
+static void pokeysnd_process_blep(void *sndbuffer, int sndn)
+{
+	UBYTE *buffer = (UBYTE *) sndbuffer;
+	SWORD *buffer16 = (SWORD *) sndbuffer;
+	uint32_t event_min;
+	UBYTE next_event;
+	int level = POKEYSND_SAMP_MIN + POKEYSND_sampout;
+	int chan;
+
+	/* the volumes may have changed since the last call */
+	for (chan = 0; chan < Num_pokeys * 4; chan++)
+		if (Outvol[chan])
+			level += pokeysnd_AUDV[chan];
+#ifdef SYNCHRONIZED_SOUND
+	level += speaker;
+#endif
+	if (level != blep_level)
+		blep_add_step(level - blep_level, blep_phase());
+
+	while (sndn) {
+		next_event = rf_next_event(&event_min);
+
+		if (next_event != SAMPLE) {
+			int delta = rf_channel_event(next_event, event_min);
+			if (delta)
+				blep_add_step(delta, blep_phase());
+		}
+		else {
+			int sampout = POKEYSND_sampout;
+			int smp;
+
+			rf_update_vol_only();
+			if (POKEYSND_sampout != sampout)
+				blep_add_step(POKEYSND_sampout - sampout, 0);
+
+			blep_sum += blep_buffer[blep_pos];
+			if (++blep_pos == BLEP_BUFFER_SIZE) {
+				memmove(blep_buffer, blep_buffer + BLEP_BUFFER_SIZE, BLEP_TAPS * sizeof(int));
+				memset(blep_buffer + BLEP_TAPS, 0, BLEP_BUFFER_SIZE * sizeof(int));
+				blep_pos = 0;
+			}
+
+			if (POKEYSND_snd_flags & POKEYSND_BIT16) {
+				/* as pokeysnd_process_16(), keeping 8 bits of the fraction */
+				smp = (((blep_sum >> (BLEP_SHIFT - 8)) - (POKEYSND_SAMP_MID << 8))
+				       * POKEYSND_volume) >> 8;
+				if (POKEYSND_snd_flags & POKEYSND_STEREO)
+					POKEYSND_PUT_STEREO16(buffer16, smp);
+				else {
+					if (smp > 32767)
+						smp = 32767;
+					else if (smp < -32768)
+						smp = -32768;
+					*buffer16++ = (SWORD) smp;
+				}
+			}
+			else {
+				smp = (blep_sum + (1 << (BLEP_SHIFT - 1))) >> BLEP_SHIFT;
+				if (smp > POKEYSND_SAMP_MAX)
+					smp = POKEYSND_SAMP_MAX;
+				else if (smp < POKEYSND_SAMP_MIN)
+					smp = POKEYSND_SAMP_MIN;
+				*buffer++ = (UBYTE) smp;
+			}
+
+			SAMP_N_CNT_FIXED += Samp_n_max;
+			sndn--;
+		}
+	}
+
+	if (POKEYSND_sampbuf_rptr == POKEYSND_sampbuf_ptr)
+		POKEYSND_sampbuf_last = cpu_clock;
+}
+
 #ifdef SYNCHRONIZED_SOUND
 static void Generate_sync_rf(unsigned int num_ticks)
 {
@@ -1175,14 +1644,8 @@ static void Generate_sync_rf(unsigned int num_ticks)
 		samp_pos = new_samp_pos;
 		num_ticks -= ticks;
 
-		if (POKEYSND_snd_flags & POKEYSND_BIT16) {
-			pokeysnd_process_16(buffer, POKEYSND_num_pokeys);
-			buffer += 2 * POKEYSND_num_pokeys;
-		}
-		else {
-			pokeysnd_process_8(buffer, POKEYSND_num_pokeys);
-			buffer += POKEYSND_num_pokeys;
-		}
+		POKEYSND_Process_ptr(buffer, POKEYSND_num_pokeys);
+		buffer += POKEYSND_num_pokeys * POKEYSND_SAMPLE_SIZE(POKEYSND_snd_flags);
 
 	}
 
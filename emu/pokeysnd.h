@@ -80,13 +80,31 @@ extern "C" {
 
 /* init flags */
 #define POKEYSND_BIT16	1
+/* With POKEYSND_BIT16 and a single POKEY: each sample is written to both
+   channels of an interleaved stereo buffer, through the optional low-pass
+   filter below */
+#define POKEYSND_STEREO	2
+
+/* Size in bytes of one sample of a single POKEY for the given flags */
+#define POKEYSND_SAMPLE_SIZE(flags) \
+	((((flags) & POKEYSND_BIT16) ? 2 : 1) * (((flags) & POKEYSND_STEREO) ? 2 : 1))
 
 extern int POKEYSND_playback_freq;
 extern UBYTE POKEYSND_num_pokeys;
 extern int POKEYSND_snd_flags;
 extern int POKEYSND_volume;
 
+/* Single-pole low-pass filter (6 dB/octave) of POKEYSND_STEREO output.
+   POKEYSND_lowpass_factor is the 16.16 fixed point weight of the previous
+   output sample, 0 disables the filter */
+extern int POKEYSND_lowpass_factor;
+extern int POKEYSND_lowpass_prev;
+
 extern int POKEYSND_enable_new_pokey;
+/* With POKEYSND_enable_new_pokey FALSE: band-limit the changes of the output
+   of the standard engine, which removes most of its aliasing. Set before
+   Pokey_sound_init(). */
+extern int POKEYSND_band_limited;
 extern int POKEYSND_stereo_enabled;
 extern int POKEYSND_serio_sound_enabled;
 extern int POKEYSND_console_sound_enabled;
@@ -102,15 +120,34 @@ int POKEYSND_Init(uint32_t freq17, int playback_freq, UBYTE num_pokeys,
                      int flags
                      );
 void POKEYSND_Update(UWORD addr, UBYTE val, UBYTE /*chip*/, UBYTE gain);
+/* Called with every register write passed to POKEYSND_Update(), e.g. to
+   record it (NULL if unused) */
+extern void (*POKEYSND_trace_hook)(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain);
 void POKEYSND_UpdateConsol(int set);
 
 /* Fill sndbuffer with sndn samples of audio. Number of bytes written to
-   sndbuffer is sndn with 8-bit sound, and 2*sndn with 16-bit sound. sndn
-   must be a multiple of POKEYSND_num_pokeys. */
+   sndbuffer is sndn with 8-bit sound, 2*sndn with 16-bit sound and 4*sndn
+   with 16-bit stereo sound. sndn must be a multiple of POKEYSND_num_pokeys. */
 void Pokey_process(void *sndbuffer, int sndn);
 void Pokey_sound_init(uint32_t freq17, UWORD playback_freq, UBYTE num_pokeys, unsigned int flags);
 void POKEYSND_SetMzQuality(int quality);
 
+/* Writes the 16-bit sample smp (an int variable, which is clipped) to both
+   channels of the SWORD buffer, and advances buffer */
+#define POKEYSND_PUT_STEREO16(buffer, smp) \
+	do { \
+		if ((smp) > 32767) \
+			(smp) = 32767; \
+		else if ((smp) < -32768) \
+			(smp) = -32768; \
+		if (POKEYSND_lowpass_factor) \
+			(smp) = POKEYSND_lowpass_prev = \
+				(POKEYSND_lowpass_prev * POKEYSND_lowpass_factor \
+				 + (smp) * (0x10000 - POKEYSND_lowpass_factor)) >> 16; \
+		(buffer)[0] = (buffer)[1] = (SWORD) (smp); \
+		(buffer) += 2; \
+	} while (0)
+
 /* Volume only emulations declarations */
 #define	POKEYSND_SAMPBUF_MAX	2000
 extern int	POKEYSND_sampbuf_val[POKEYSND_SAMPBUF_MAX];	/* volume values */
@@ -129,9 +166,36 @@ extern UBYTE *POKEYSND_process_buffer;
 extern unsigned int POKEYSND_process_buffer_length;
 extern unsigned int POKEYSND_process_buffer_fill;
 extern void (*POKEYSND_GenerateSync)(unsigned int num_ticks);
+/* Rate at which frames are emulated (FPS_NTSC by default). Every frame
+   produces POKEYSND_playback_freq / POKEYSND_frame_rate samples, so a
+   frontend running at a rounded frame rate receives the sample count
+   it expects. Set before Pokey_sound_init(). */
+extern double POKEYSND_frame_rate;
+/* Generates the samples up to the current CPU cycle. */
+void POKEYSND_UpdateSync(void);
+/* Generates the samples up to the current CPU cycle, and returns the
+   number of samples in POKEYSND_process_buffer, which is then emptied. */
 int POKEYSND_UpdateProcessBuffer(void);
 #endif /* SYNCHRONIZED_SOUND */
 
+/* Synthesis on a worker thread, which replays the register writes at
+   their CPU cycle, so requires synchronized sound */
+#if defined(SYNCHRONIZED_SOUND) && defined(HAVE_PTHREAD)
+#define POKEYSND_THREAD 1
+#endif
+
+#ifdef POKEYSND_THREAD
+/* While the worker runs, POKEYSND_Update() and POKEYSND_UpdateSync() only
+   queue the write (or catch-up) with its CPU cycle, and the output is the
+   same as without the worker. Returns FALSE if the worker could not be
+   started: only the mz engine may run on it. */
+int POKEYSND_StartThread(void);
+void POKEYSND_StopThread(void);
+/* Waits until the worker has processed all queued writes. Anything else
+   accessing the engine state (e.g. save states) must call this first. */
+void POKEYSND_Flush(void);
+#endif /* POKEYSND_THREAD */
+
 #ifdef __cplusplus
 }
 
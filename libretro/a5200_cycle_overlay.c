@@ -0,0 +1,80 @@
+#include "a5200_cycle_overlay.h"
+
+#define OVERLAY_DMA_COLOUR   ((0xE0 >> 3) << 11 | (0x30 >> 3) << 6 | (0x30 >> 3))
+#define OVERLAY_CPU_COLOUR   ((0x30 >> 3) << 11 | (0xD0 >> 3) << 6 | (0x30 >> 3))
+#define OVERLAY_WSYNC_COLOUR ((0x40 >> 3) << 11 | (0x60 >> 3) << 6 | (0xF0 >> 3))
+#define OVERLAY_DLI_COLOUR   ((0xFF >> 3) << 11 | (0xF1 >> 3) << 6 | (0x33 >> 3))
+#define OVERLAY_VBI_COLOUR   ((0xF3 >> 3) << 11 | (0xF3 >> 3) << 6 | (0xF3 >> 3))
+#define OVERLAY_BG_COLOUR    0
+
+/* One pixel per cycle (two cycles at half width).
+ * Bars are sized for a full line, plus room for
+ * the instructions crossing the end of the line */
+#define OVERLAY_BAR_CYCLES (LINE_C + 8)
+#define OVERLAY_MARKER_WIDTH 3
+
+/* Fills 'cycles' cycles of the bar starting at
+ * 'pos', returning the position after them */
+static size_t overlay_fill(uint16_t *bar, size_t pos, size_t bar_width,
+      unsigned cycles, unsigned x_shift, uint16_t colour)
+{
+   size_t end = pos + (cycles >> x_shift);
+
+   if (end > bar_width)
+      end = bar_width;
+
+   for (; pos < end; pos++)
+      bar[pos] = colour;
+
+   return pos;
+}
+
+void a5200_cycle_overlay_draw(uint16_t *buffer, size_t width, size_t height,
+      bool half_width, const ANTIC_line_stat *stats, int lines,
+      int first_line)
+{
+   unsigned x_shift = half_width ? 1 : 0;
+   size_t bar_width = OVERLAY_BAR_CYCLES >> x_shift;
+   size_t x_offset;
+   size_t y;
+
+   if (!stats || (width < bar_width + OVERLAY_MARKER_WIDTH))
+      return;
+
+   x_offset = width - bar_width;
+
+   for (y = 0; y < height; y++)
+   {
+      int line              = first_line + (int)y;
+      uint16_t *marker      = buffer + (y * width) + x_offset -
+            OVERLAY_MARKER_WIDTH;
+      uint16_t *bar         = buffer + (y * width) + x_offset;
+      const ANTIC_line_stat *stat;
+      uint16_t marker_colour;
+      size_t pos;
+      size_t i;
+
+      if ((line < 0) || (line >= lines))
+         continue;
+
+      stat = &stats[line];
+
+      /* DLI/VBI marker */
+      marker_colour = (stat->nmi & ANTIC_LINE_VBI) ? OVERLAY_VBI_COLOUR :
+            (stat->nmi & ANTIC_LINE_DLI) ? OVERLAY_DLI_COLOUR :
+                  OVERLAY_BG_COLOUR;
+
+      for (i = 0; i < OVERLAY_MARKER_WIDTH; i++)
+         marker[i] = marker_colour;
+
+      /* Cycle bar */
+      pos = overlay_fill(bar, 0, bar_width, stat->dma_cycles, x_shift,
+            OVERLAY_DMA_COLOUR);
+      pos = overlay_fill(bar, pos, bar_width, stat->cpu_cycles, x_shift,
+            OVERLAY_CPU_COLOUR);
+      pos = overlay_fill(bar, pos, bar_width, stat->wsync_cycles, x_shift,
+            OVERLAY_WSYNC_COLOUR);
+      overlay_fill(bar, pos, bar_width, OVERLAY_BAR_CYCLES, 0,
+            OVERLAY_BG_COLOUR);
+   }
+}
@@ -0,0 +1,24 @@
+#ifndef A5200_CYCLE_OVERLAY_H__
+#define A5200_CYCLE_OVERLAY_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <boolean.h>
+
+#include "antic.h"
+
+/* Draws a bar for each line of 'buffer' at its
+ * right edge, showing how the cycles of the
+ * corresponding scanline were spent: ANTIC DMA
+ * (red), CPU (green) and WSYNC halt (blue). DLI
+ * and VBI entry is marked to the left of the bar
+ * (yellow/white). 'first_line' is the scanline
+ * (ypos) shown on the first line of 'buffer'.
+ * If half_width is set, the bars are drawn at
+ * half horizontal resolution */
+void a5200_cycle_overlay_draw(uint16_t *buffer, size_t width, size_t height,
+      bool half_width, const ANTIC_line_stat *stats, int lines,
+      int first_line);
+
+#endif
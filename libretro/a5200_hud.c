@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "a5200_hud.h"
+
+#define HUD_TEXT_COLOUR ((0xFF >> 3) << 11 | (0xF1 >> 3) << 6 | (0x33 >> 3))
+/* Background pixels are darkened rather than
+ * overwritten, so the game remains visible */
+#define HUD_DARKEN(p) (((p) >> 1) & 0x7BCF)
+
+#define HUD_GLYPH_WIDTH 3
+#define HUD_GLYPH_HEIGHT 5
+#define HUD_CHAR_WIDTH (HUD_GLYPH_WIDTH + 1)
+#define HUD_LINE_HEIGHT (HUD_GLYPH_HEIGHT + 2)
+#define HUD_BORDER 2
+#define HUD_NUM_LINES 3
+#define HUD_MAX_LINE_LENGTH 64
+
+/* 3x5 font: each row is a 3 bit mask,
+ * MSB is the leftmost pixel */
+static const uint8_t hud_font_digits[10][HUD_GLYPH_HEIGHT] = {
+   { 7, 5, 5, 5, 7 }, { 2, 6, 2, 2, 7 }, { 7, 1, 7, 4, 7 },
+   { 7, 1, 3, 1, 7 }, { 5, 5, 7, 1, 1 }, { 7, 4, 7, 1, 7 },
+   { 7, 4, 7, 5, 7 }, { 7, 1, 1, 2, 2 }, { 7, 5, 7, 5, 7 },
+   { 7, 5, 7, 1, 7 }
+};
+
+static const uint8_t hud_font_letters[26][HUD_GLYPH_HEIGHT] = {
+   { 2, 5, 7, 5, 5 }, { 6, 5, 6, 5, 6 }, { 3, 4, 4, 4, 3 },
+   { 6, 5, 5, 5, 6 }, { 7, 4, 6, 4, 7 }, { 7, 4, 6, 4, 4 },
+   { 3, 4, 5, 5, 3 }, { 5, 5, 7, 5, 5 }, { 7, 2, 2, 2, 7 },
+   { 1, 1, 1, 5, 2 }, { 5, 5, 6, 5, 5 }, { 4, 4, 4, 4, 7 },
+   { 5, 7, 7, 5, 5 }, { 6, 5, 5, 5, 5 }, { 2, 5, 5, 5, 2 },
+   { 6, 5, 6, 4, 4 }, { 2, 5, 5, 6, 3 }, { 6, 5, 6, 5, 5 },
+   { 3, 4, 2, 1, 6 }, { 7, 2, 2, 2, 2 }, { 5, 5, 5, 5, 7 },
+   { 5, 5, 5, 5, 2 }, { 5, 5, 7, 7, 5 }, { 5, 5, 2, 5, 5 },
+   { 5, 5, 2, 2, 2 }, { 7, 1, 2, 4, 7 }
+};
+
+static const uint8_t hud_font_percent[HUD_GLYPH_HEIGHT] = { 5, 1, 2, 4, 5 };
+static const uint8_t hud_font_slash[HUD_GLYPH_HEIGHT]   = { 1, 1, 2, 4, 4 };
+static const uint8_t hud_font_dot[HUD_GLYPH_HEIGHT]     = { 0, 0, 0, 0, 2 };
+static const uint8_t hud_font_dash[HUD_GLYPH_HEIGHT]    = { 0, 0, 7, 0, 0 };
+
+static const uint8_t *hud_get_glyph(char c)
+{
+   if ((c >= '0') && (c <= '9'))
+      return hud_font_digits[c - '0'];
+
+   c = (char)toupper((unsigned char)c);
+
+   if ((c >= 'A') && (c <= 'Z'))
+      return hud_font_letters[c - 'A'];
+
+   switch (c)
+   {
+      case '%':
+         return hud_font_percent;
+      case '/':
+         return hud_font_slash;
+      case '.':
+         return hud_font_dot;
+      case '-':
+         return hud_font_dash;
+      default:
+         break;
+   }
+
+   return NULL;
+}
+
+static void hud_draw_text(uint16_t *buffer, size_t width,
+      size_t x, size_t y, const char *text)
+{
+   for (; *text != '\0'; text++, x += HUD_CHAR_WIDTH)
+   {
+      const uint8_t *glyph = hud_get_glyph(*text);
+      size_t glyph_x, glyph_y;
+
+      if (!glyph)
+         continue;
+
+      for (glyph_y = 0; glyph_y < HUD_GLYPH_HEIGHT; glyph_y++)
+      {
+         uint16_t *dst = buffer + ((y + glyph_y) * width) + x;
+
+         for (glyph_x = 0; glyph_x < HUD_GLYPH_WIDTH; glyph_x++)
+            if (glyph[glyph_y] & (4 >> glyph_x))
+               dst[glyph_x] = HUD_TEXT_COLOUR;
+      }
+   }
+}
+
+/* Formats a time in microseconds as
+ * milliseconds with two decimals */
+static void hud_format_time(char *s, size_t len, int usec)
+{
+   if (usec < 0)
+      snprintf(s, len, "--");
+   else
+      snprintf(s, len, "%d.%02d", usec / 1000, (usec % 1000) / 10);
+}
+
+void a5200_hud_draw(uint16_t *buffer, size_t width, size_t height,
+      const a5200_hud_stats_t *stats)
+{
+   char lines[HUD_NUM_LINES][HUD_MAX_LINE_LENGTH];
+   char emulation[16];
+   char video[16];
+   char audio[16];
+   char occupancy[16];
+   size_t box_width  = 0;
+   size_t box_height = (HUD_NUM_LINES * HUD_LINE_HEIGHT) -
+         (HUD_LINE_HEIGHT - HUD_GLYPH_HEIGHT) + (2 * HUD_BORDER);
+   size_t x, y;
+   unsigned i;
+
+   if (!stats)
+      return;
+
+   hud_format_time(emulation, sizeof(emulation), stats->emulation_usec);
+   hud_format_time(video, sizeof(video), stats->video_usec);
+   hud_format_time(audio, sizeof(audio), stats->audio_usec);
+
+   if (stats->audio_buffer_occupancy < 0)
+      snprintf(occupancy, sizeof(occupancy), "--");
+   else
+      snprintf(occupancy, sizeof(occupancy), "%d%%",
+            stats->audio_buffer_occupancy);
+
+   snprintf(lines[0], sizeof(lines[0]), "EMU %s VID %s AUD %s",
+         emulation, video, audio);
+   snprintf(lines[1], sizeof(lines[1]), "CPU %u%% DMA %u%% WSYNC %u%%",
+         stats->cpu_percent, stats->dma_percent, stats->wsync_percent);
+   snprintf(lines[2], sizeof(lines[2]), "SKIP %s %u/%u BUF %s",
+         stats->frameskip_mode ? stats->frameskip_mode : "--",
+         stats->frames_skipped, stats->frames, occupancy);
+
+   for (i = 0; i < HUD_NUM_LINES; i++)
+   {
+      size_t line_width = (strlen(lines[i]) * HUD_CHAR_WIDTH) - 1 +
+            (2 * HUD_BORDER);
+
+      if (line_width > box_width)
+         box_width = line_width;
+   }
+
+   if ((width < box_width) || (height < box_height))
+      return;
+
+   /* Darken background */
+   for (y = 0; y < box_height; y++)
+   {
+      uint16_t *dst = buffer + (y * width);
+
+      for (x = 0; x < box_width; x++)
+         dst[x] = HUD_DARKEN(dst[x]);
+   }
+
+   for (i = 0; i < HUD_NUM_LINES; i++)
+      hud_draw_text(buffer, width, HUD_BORDER,
+            HUD_BORDER + (i * HUD_LINE_HEIGHT), lines[i]);
+}
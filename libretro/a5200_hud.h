@@ -0,0 +1,37 @@
+#ifndef A5200_HUD_H__
+#define A5200_HUD_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <boolean.h>
+
+typedef struct
+{
+   /* Host time spent per frame, in microseconds
+    * (negative if no timer is available) */
+   int emulation_usec;
+   int video_usec;
+   int audio_usec;
+   /* Share of the emulated cycles of a frame
+    * executed by the CPU, stolen by ANTIC DMA
+    * and spent halted by WSYNC (percent) */
+   unsigned cpu_percent;
+   unsigned dma_percent;
+   unsigned wsync_percent;
+   /* Frameskip mode, and number of frames
+    * skipped out of the last 'frames' */
+   const char *frameskip_mode;
+   unsigned frames_skipped;
+   unsigned frames;
+   /* Frontend audio buffer occupancy (percent,
+    * negative if not reported by the frontend) */
+   int audio_buffer_occupancy;
+} a5200_hud_stats_t;
+
+/* Draws 'stats' in the top left corner
+ * of the 'width' x 'height' buffer */
+void a5200_hud_draw(uint16_t *buffer, size_t width, size_t height,
+      const a5200_hud_stats_t *stats);
+
+#endif
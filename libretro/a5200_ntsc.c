@@ -0,0 +1,231 @@
+#include <math.h>
+#include <string.h>
+
+#include "a5200_ntsc.h"
+
+/* NTSC composite video simulation
+ *
+ * The GTIA outputs one colour clock per cycle of the
+ * NTSC colour subcarrier, i.e. the screen buffer holds
+ * two pixels per subcarrier cycle. The composite signal
+ * is modelled at four samples per cycle: each pixel
+ * contributes luma plus chroma modulated at its position
+ * in the cycle. The decoder separates luma with a filter
+ * that cancels the subcarrier, and demodulates chroma
+ * through a wider low-pass filter - so colours bleed
+ * into their neighbours, and hi-res luma detail turns
+ * into artifact colours, as on a real TV.
+ *
+ * The whole chain is linear, so the contribution of a
+ * pixel of a given colour and phase to each nearby output
+ * pixel can be precomputed (in RGB). Output pixels are
+ * then the sum of NTSC_TAPS kernel entries. Kernel
+ * entries hold the three channels in one 64 bit word,
+ * with a bias large enough that no channel can ever
+ * borrow from its neighbour, so all channels are
+ * accumulated with one addition per tap */
+
+/* Each output pixel depends on the input
+ * pixels up to NTSC_RADIUS away */
+#define NTSC_RADIUS 3
+#define NTSC_TAPS ((2 * NTSC_RADIUS) + 1)
+
+/* Channel values are stored in 1/64 units */
+#define NTSC_FRAC_BITS 6
+#define NTSC_TAP_BIAS (1 << 15)
+#define NTSC_FIELD_BITS 21
+#define NTSC_FIELD_MASK ((1 << NTSC_FIELD_BITS) - 1)
+
+/* Must be able to hold a full ATARI_WIDTH line */
+#define NTSC_MAX_WIDTH 384
+
+/* Luma filter [1 2 2 2 1]/8 and chroma filter
+ * [1 2 3 4 4 4 4 4 3 2 1]/32 (in samples) both
+ * cancel the subcarrier and its second harmonic */
+#define NTSC_LUMA_RADIUS 2
+#define NTSC_CHROMA_RADIUS 5
+
+static const float ntsc_luma_filter[(2 * NTSC_LUMA_RADIUS) + 1] = {
+   1.0f / 8.0f, 2.0f / 8.0f, 2.0f / 8.0f, 2.0f / 8.0f, 1.0f / 8.0f
+};
+
+static const float ntsc_chroma_filter[(2 * NTSC_CHROMA_RADIUS) + 1] = {
+   1.0f / 32.0f, 2.0f / 32.0f, 3.0f / 32.0f, 4.0f / 32.0f,
+   4.0f / 32.0f, 4.0f / 32.0f, 4.0f / 32.0f, 4.0f / 32.0f,
+   3.0f / 32.0f, 2.0f / 32.0f, 1.0f / 32.0f
+};
+
+/* [colour][pixel phase][tap]: contribution of an input
+ * pixel to the output pixel (NTSC_RADIUS - tap) to its
+ * right, i.e. tap 0 is used for the input pixel
+ * NTSC_RADIUS to the left of the output pixel */
+static uint64_t ntsc_kernels[256][2][NTSC_TAPS];
+
+/* Subcarrier phase of sample n is n * 90 degrees */
+static float ntsc_cos(int n)
+{
+   static const float table[4] = { 1.0f, 0.0f, -1.0f, 0.0f };
+   return table[n & 3];
+}
+
+static float ntsc_sin(int n)
+{
+   static const float table[4] = { 0.0f, 1.0f, 0.0f, -1.0f };
+   return table[n & 3];
+}
+
+/* Decodes the signal of a single pixel at position
+ * 'pixel', whose samples are given, at sample 'n' */
+static void ntsc_decode(const float *signal, int pixel, int n,
+      float *y, float *i, float *q)
+{
+   int j;
+
+   *y = *i = *q = 0.0f;
+
+   for (j = -NTSC_CHROMA_RADIUS; j <= NTSC_CHROMA_RADIUS; j++)
+   {
+      int m = n - j;
+      float s;
+
+      if ((m != 2 * pixel) && (m != (2 * pixel) + 1))
+         continue;
+
+      s = signal[m - (2 * pixel)];
+
+      if ((j >= -NTSC_LUMA_RADIUS) && (j <= NTSC_LUMA_RADIUS))
+         *y += ntsc_luma_filter[j + NTSC_LUMA_RADIUS] * s;
+
+      *i += 2.0f * ntsc_chroma_filter[j + NTSC_CHROMA_RADIUS] * s * ntsc_cos(m);
+      *q += 2.0f * ntsc_chroma_filter[j + NTSC_CHROMA_RADIUS] * s * ntsc_sin(m);
+   }
+}
+
+static uint64_t ntsc_pack_tap(float r, float g, float b)
+{
+   float scale = (float)(1 << NTSC_FRAC_BITS);
+   uint64_t r_field = (uint64_t)(long)(floorf(r * scale + 0.5f) + NTSC_TAP_BIAS);
+   uint64_t g_field = (uint64_t)(long)(floorf(g * scale + 0.5f) + NTSC_TAP_BIAS);
+   uint64_t b_field = (uint64_t)(long)(floorf(b * scale + 0.5f) + NTSC_TAP_BIAS);
+
+   return (r_field << (2 * NTSC_FIELD_BITS)) |
+          (g_field << NTSC_FIELD_BITS) | b_field;
+}
+
+void a5200_ntsc_init(const uint32_t *palette)
+{
+   int c, phase, tap;
+
+   for (c = 0; c < 256; c++)
+   {
+      float r = (float)((palette[c] >> 16) & 0xFF);
+      float g = (float)((palette[c] >>  8) & 0xFF);
+      float b = (float)((palette[c]      ) & 0xFF);
+      float y = (0.299f * r) + (0.587f * g) + (0.114f * b);
+      float i = (0.596f * r) - (0.274f * g) - (0.322f * b);
+      float q = (0.211f * r) - (0.523f * g) + (0.312f * b);
+
+      for (phase = 0; phase < 2; phase++)
+      {
+         float signal[2];
+         int n;
+
+         /* Composite signal of the pixel */
+         for (n = 0; n < 2; n++)
+         {
+            int m = (2 * phase) + n;
+            signal[n] = y + (i * ntsc_cos(m)) + (q * ntsc_sin(m));
+         }
+
+         for (tap = 0; tap < NTSC_TAPS; tap++)
+         {
+            /* Output pixel this tap contributes to */
+            int x = phase + NTSC_RADIUS - tap;
+            float y0, i0, q0, y1, i1, q1;
+            float y_out, i_out, q_out;
+
+            /* Output pixels average their two samples */
+            ntsc_decode(signal, phase, 2 * x, &y0, &i0, &q0);
+            ntsc_decode(signal, phase, (2 * x) + 1, &y1, &i1, &q1);
+
+            y_out = 0.5f * (y0 + y1);
+            i_out = 0.5f * (i0 + i1);
+            q_out = 0.5f * (q0 + q1);
+
+            ntsc_kernels[c][phase][tap] = ntsc_pack_tap(
+                  y_out + (0.956f * i_out) + (0.621f * q_out),
+                  y_out - (0.272f * i_out) - (0.647f * q_out),
+                  y_out - (1.106f * i_out) + (1.703f * q_out));
+         }
+      }
+   }
+}
+
+/* Converts the sum of 'taps' kernel entries to RGB565,
+ * 'shift' removing the fractional bits (and averaging,
+ * when two output pixels are summed) */
+static uint16_t ntsc_to_rgb565(uint64_t sum, int taps, int shift)
+{
+   int bias = taps * NTSC_TAP_BIAS;
+   int rounding = 1 << (shift - 1);
+   int r = (int)((sum >> (2 * NTSC_FIELD_BITS)) & NTSC_FIELD_MASK) - bias;
+   int g = (int)((sum >> NTSC_FIELD_BITS) & NTSC_FIELD_MASK) - bias;
+   int b = (int)(sum & NTSC_FIELD_MASK) - bias;
+
+   r = (r < 0) ? 0 : (r + rounding) >> shift;
+   g = (g < 0) ? 0 : (g + rounding) >> shift;
+   b = (b < 0) ? 0 : (b + rounding) >> shift;
+
+   r = (r > 0xFF) ? 0xFF : r;
+   g = (g > 0xFF) ? 0xFF : g;
+   b = (b > 0xFF) ? 0xFF : b;
+
+   return (r >> 3) << 11 | (g >> 3) << 6 | (b >> 3);
+}
+
+static uint64_t ntsc_sum(const uint8_t *line, int x)
+{
+   /* line[x + NTSC_RADIUS] is input pixel x */
+   const uint8_t *in = line + x;
+   int phase         = x & 1;
+
+   return ntsc_kernels[in[0]][phase ^ 1][0] +
+          ntsc_kernels[in[1]][phase    ][1] +
+          ntsc_kernels[in[2]][phase ^ 1][2] +
+          ntsc_kernels[in[3]][phase    ][3] +
+          ntsc_kernels[in[4]][phase ^ 1][4] +
+          ntsc_kernels[in[5]][phase    ][5] +
+          ntsc_kernels[in[6]][phase ^ 1][6];
+}
+
+void a5200_ntsc_blit(const uint8_t *in, size_t in_pitch,
+      uint16_t *out, size_t out_pitch,
+      size_t width, size_t height, bool half_width)
+{
+   uint8_t line[NTSC_MAX_WIDTH + (2 * NTSC_RADIUS)];
+   size_t x, y;
+
+   if ((width < 1) || (width > NTSC_MAX_WIDTH))
+      return;
+
+   for (y = 0; y < height; y++)
+   {
+      uint16_t *out_ptr = out + (y * out_pitch);
+
+      /* Pixels beyond the edges repeat the edge pixels */
+      memcpy(line + NTSC_RADIUS, in + (y * in_pitch), width);
+      memset(line, line[NTSC_RADIUS], NTSC_RADIUS);
+      memset(line + NTSC_RADIUS + width,
+            line[NTSC_RADIUS + width - 1], NTSC_RADIUS);
+
+      if (half_width)
+         for (x = 0; x + 1 < width; x += 2)
+            *(out_ptr++) = ntsc_to_rgb565(
+                  ntsc_sum(line, (int)x) + ntsc_sum(line, (int)x + 1),
+                  2 * NTSC_TAPS, NTSC_FRAC_BITS + 1);
+      else
+         for (x = 0; x < width; x++)
+            *(out_ptr++) = ntsc_to_rgb565(ntsc_sum(line, (int)x),
+                  NTSC_TAPS, NTSC_FRAC_BITS);
+   }
+}
@@ -0,0 +1,21 @@
+#ifndef A5200_NTSC_H__
+#define A5200_NTSC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <boolean.h>
+
+/* Builds the filter kernels for the specified
+ * 256 entry 0xRRGGBB palette */
+void a5200_ntsc_init(const uint32_t *palette);
+
+/* Converts 'height' lines of 'width' indexed pixels
+ * (two per colour clock) to RGB565 via a simulated
+ * NTSC composite signal. If half_width is set, one
+ * output pixel is generated per colour clock */
+void a5200_ntsc_blit(const uint8_t *in, size_t in_pitch,
+      uint16_t *out, size_t out_pitch,
+      size_t width, size_t height, bool half_width);
+
+#endif
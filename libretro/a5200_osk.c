@@ -310,22 +310,28 @@ void a5200_osk_deinit(void)
    osk_cursor_idx = 0;
 }
 
-void a5200_osk_draw(uint16_t *buffer, size_t width, size_t height)
+void a5200_osk_draw(uint16_t *buffer, size_t width, size_t height,
+      bool half_width)
 {
    uint16_t *src = NULL;
    uint16_t *dst = NULL;
+   unsigned x_shift = half_width ? 1 : 0;
+   size_t bmp_width = OSK_BMP_WIDTH >> x_shift;
    size_t bmp_offset_x;
    size_t bmp_offset_y;
+   size_t bmp_x;
    size_t bmp_y;
    size_t cursor_x;
    size_t cursor_y;
+   size_t cursor_width;
+   size_t cursor_border;
 
-   if ((width < OSK_BMP_WIDTH) ||
+   if ((width < bmp_width) ||
        (height < OSK_BMP_HEIGHT))
       return;
 
    /* Get draw position */
-   bmp_offset_x = (width - OSK_BMP_WIDTH) >> 1;
+   bmp_offset_x = (width - bmp_width) >> 1;
    bmp_offset_y = (height - OSK_BMP_HEIGHT);
 
    /* Copy OSK bitmap to buffer */
@@ -333,33 +339,39 @@ void a5200_osk_draw(uint16_t *buffer, size_t width, size_t height)
    {
       src = osk_bmp + (bmp_y * OSK_BMP_WIDTH);
       dst = buffer + bmp_offset_x + ((bmp_y + bmp_offset_y) * width);
-      
-      memcpy(dst, src, OSK_BMP_WIDTH * sizeof(uint16_t));
+
+      if (half_width)
+         for (bmp_x = 0; bmp_x < bmp_width; bmp_x++)
+            *(dst++) = *(src + (bmp_x << 1));
+      else
+         memcpy(dst, src, OSK_BMP_WIDTH * sizeof(uint16_t));
    }
 
    /* Draw cursor */
-   cursor_x = bmp_offset_x + OSK_BORDER_WIDTH + (osk_cursor_idx *
-         (OSK_KEY_WIDTH + (3 * OSK_BORDER_WIDTH)));
+   cursor_x = bmp_offset_x + ((OSK_BORDER_WIDTH + (osk_cursor_idx *
+         (OSK_KEY_WIDTH + (3 * OSK_BORDER_WIDTH)))) >> x_shift);
    cursor_y = bmp_offset_y + OSK_BORDER_WIDTH;
+   cursor_width  = (OSK_KEY_WIDTH + (2 * OSK_BORDER_WIDTH)) >> x_shift;
+   cursor_border = OSK_BORDER_WIDTH >> x_shift;
 
    osk_draw_rect(buffer, width, height,
          cursor_x, cursor_y,
-         OSK_KEY_WIDTH + (2 * OSK_BORDER_WIDTH), OSK_BORDER_WIDTH,
+         cursor_width, OSK_BORDER_WIDTH,
          OSK_CURSOR_COLOUR);
 
    osk_draw_rect(buffer, width, height,
          cursor_x, cursor_y + OSK_KEY_HEIGHT + OSK_BORDER_WIDTH,
-         OSK_KEY_WIDTH + (2 * OSK_BORDER_WIDTH), OSK_BORDER_WIDTH,
+         cursor_width, OSK_BORDER_WIDTH,
          OSK_CURSOR_COLOUR);
 
    osk_draw_rect(buffer, width, height,
          cursor_x, cursor_y + OSK_BORDER_WIDTH,
-         OSK_BORDER_WIDTH, OSK_KEY_HEIGHT,
+         cursor_border, OSK_KEY_HEIGHT,
          OSK_CURSOR_COLOUR);
 
    osk_draw_rect(buffer, width, height,
-         cursor_x + OSK_KEY_WIDTH + OSK_BORDER_WIDTH, cursor_y + OSK_BORDER_WIDTH,
-         OSK_BORDER_WIDTH, OSK_KEY_HEIGHT,
+         cursor_x + cursor_width - cursor_border, cursor_y + OSK_BORDER_WIDTH,
+         cursor_border, OSK_KEY_HEIGHT,
          OSK_CURSOR_COLOUR);
 }
 
@@ -4,10 +4,15 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include <boolean.h>
+
 void a5200_osk_init(void);
 void a5200_osk_deinit(void);
 
-void a5200_osk_draw(uint16_t *buffer, size_t width, size_t height);
+/* If half_width is set, the keyboard is drawn
+ * at half horizontal resolution */
+void a5200_osk_draw(uint16_t *buffer, size_t width, size_t height,
+      bool half_width);
 void a5200_osk_move_cursor(int delta);
 unsigned a5200_osk_get_key(void);
 
@@ -0,0 +1,133 @@
+#include <string.h>
+
+#include <streams/file_stream.h>
+
+#include "a5200_pokey_trace.h"
+
+#define POKEY_TRACE_BUFFER_SIZE 65536
+/* Largest record: tag, 5 byte LEB128 delta, value */
+#define POKEY_TRACE_RECORD_MAX 7
+
+static RFILE *pokey_trace_file = NULL;
+static uint8_t pokey_trace_buffer[POKEY_TRACE_BUFFER_SIZE];
+static size_t pokey_trace_fill    = 0;
+static uint32_t pokey_trace_tick  = 0;
+/* Gain of the last write (-1 until the first) */
+static int pokey_trace_gain       = -1;
+static bool pokey_trace_error     = false;
+
+static void pokey_trace_flush(void)
+{
+   if (pokey_trace_fill > 0 &&
+       filestream_write(pokey_trace_file, pokey_trace_buffer,
+            pokey_trace_fill) != (int64_t)pokey_trace_fill)
+      pokey_trace_error = true;
+
+   pokey_trace_fill = 0;
+}
+
+static void pokey_trace_put_u16(uint8_t *data, uint16_t value)
+{
+   data[0] = value & 0xFF;
+   data[1] = value >> 8;
+}
+
+static void pokey_trace_put_u32(uint8_t *data, uint32_t value)
+{
+   pokey_trace_put_u16(data, value & 0xFFFF);
+   pokey_trace_put_u16(data + 2, value >> 16);
+}
+
+/* Starts a record: tag plus delta to 'tick' */
+static void pokey_trace_begin_record(uint8_t tag, uint32_t tick)
+{
+   uint32_t delta = tick - pokey_trace_tick;
+   uint8_t *out;
+
+   if (POKEY_TRACE_BUFFER_SIZE - pokey_trace_fill < POKEY_TRACE_RECORD_MAX)
+      pokey_trace_flush();
+
+   /* The cycle counter steps back slightly
+    * when a save state is loaded */
+   if ((int32_t)delta < 0)
+      delta = 0;
+   pokey_trace_tick = tick;
+
+   out    = pokey_trace_buffer + pokey_trace_fill;
+   *out++ = tag;
+   while (delta >= 0x80)
+   {
+      *out++  = (delta & 0x7F) | 0x80;
+      delta >>= 7;
+   }
+   *out++ = delta;
+
+   pokey_trace_fill = out - pokey_trace_buffer;
+}
+
+bool a5200_pokey_trace_open(const char *path,
+      uint32_t frame_rate_mhz, uint16_t frame_lines)
+{
+   uint8_t *header = pokey_trace_buffer;
+
+   a5200_pokey_trace_close();
+
+   pokey_trace_file = filestream_open(path,
+         RETRO_VFS_FILE_ACCESS_WRITE,
+         RETRO_VFS_FILE_ACCESS_HINT_NONE);
+
+   if (!pokey_trace_file)
+      return false;
+
+   memset(header, 0, A5200_POKEY_TRACE_HEADER_SIZE);
+   memcpy(header, A5200_POKEY_TRACE_MAGIC, 7);
+   header[7] = A5200_POKEY_TRACE_VERSION;
+   pokey_trace_put_u32(header + 8, frame_rate_mhz);
+   pokey_trace_put_u16(header + 12, frame_lines);
+
+   pokey_trace_fill  = A5200_POKEY_TRACE_HEADER_SIZE;
+   pokey_trace_tick  = 0;
+   pokey_trace_gain  = -1;
+   pokey_trace_error = false;
+   return true;
+}
+
+void a5200_pokey_trace_close(void)
+{
+   if (!pokey_trace_file)
+      return;
+
+   pokey_trace_flush();
+   filestream_close(pokey_trace_file);
+   pokey_trace_file = NULL;
+}
+
+bool a5200_pokey_trace_active(void)
+{
+   return pokey_trace_file && !pokey_trace_error;
+}
+
+void a5200_pokey_trace_write(uint32_t tick, uint8_t chip,
+      uint8_t reg, uint8_t value, uint8_t gain)
+{
+   if (!a5200_pokey_trace_active())
+      return;
+
+   if (gain != pokey_trace_gain)
+   {
+      pokey_trace_begin_record(A5200_POKEY_TRACE_GAIN, tick);
+      pokey_trace_buffer[pokey_trace_fill++] = gain;
+      pokey_trace_gain = gain;
+   }
+
+   pokey_trace_begin_record(((chip & 1) << 4) | (reg & 0x0F), tick);
+   pokey_trace_buffer[pokey_trace_fill++] = value;
+}
+
+void a5200_pokey_trace_frame(uint32_t tick)
+{
+   if (!a5200_pokey_trace_active())
+      return;
+
+   pokey_trace_begin_record(A5200_POKEY_TRACE_FRAME, tick);
+}
@@ -0,0 +1,53 @@
+#ifndef A5200_POKEY_TRACE_H__
+#define A5200_POKEY_TRACE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <boolean.h>
+
+/* Records every write to the POKEY sound registers
+ * with the CPU cycle it occurs at, so that the sound
+ * engines may be benchmarked in isolation (see
+ * tools/pokey_bench). Records are buffered and
+ * streamed to the file, so there is no limit on
+ * the length of a recording.
+ *
+ * File format (little endian):
+ *   header: "A52PTRC" + version byte,
+ *           uint32 frame rate in 1/1000 Hz,
+ *           uint16 scanlines per frame,
+ *           uint16 reserved (0)
+ *   records: tag byte, then the number of CPU
+ *           cycles since the previous record (LEB128
+ *           encoded, negative steps are stored as 0),
+ *           then:
+ *     tag < A5200_POKEY_TRACE_GAIN: register write,
+ *           tag = (chip << 4) | register offset,
+ *           followed by the value byte
+ *     A5200_POKEY_TRACE_GAIN: gain byte, which
+ *           applies to all following writes
+ *     A5200_POKEY_TRACE_FRAME: end of frame, i.e.
+ *           the point at which samples are output */
+
+#define A5200_POKEY_TRACE_MAGIC "A52PTRC"
+#define A5200_POKEY_TRACE_VERSION 1
+#define A5200_POKEY_TRACE_HEADER_SIZE 16
+
+#define A5200_POKEY_TRACE_GAIN  0xFE
+#define A5200_POKEY_TRACE_FRAME 0xFF
+
+/* Creates the file at 'path' and starts recording
+ * (closing any previous recording). Returns false
+ * on error */
+bool a5200_pokey_trace_open(const char *path,
+      uint32_t frame_rate_mhz, uint16_t frame_lines);
+/* Writes any buffered records and closes the file */
+void a5200_pokey_trace_close(void);
+bool a5200_pokey_trace_active(void);
+
+void a5200_pokey_trace_write(uint32_t tick, uint8_t chip,
+      uint8_t reg, uint8_t value, uint8_t gain);
+void a5200_pokey_trace_frame(uint32_t tick);
+
+#endif
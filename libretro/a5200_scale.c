@@ -0,0 +1,188 @@
+#include <string.h>
+
+#include "a5200_scale.h"
+
+/* Integer scalers
+ *
+ * Applied to the RGB565 frame after palette
+ * conversion/filtering, so frontends without
+ * shader support receive a pre-scaled image.
+ * Pixels are written two at a time where the
+ * output layout allows it */
+
+/* Halves the brightness of each colour channel
+ * of two packed RGB565 pixels (green occupies
+ * bits 6-10, bit 5 is always zero) */
+#define SCALE_DARKEN_PAIR(p) (((p) >> 1) & 0x7BCF7BCF)
+
+unsigned a5200_scale_factor(enum a5200_scaler_type type)
+{
+   switch (type)
+   {
+      case A5200_SCALER_2X:
+      case A5200_SCALER_2X_SCANLINES:
+      case A5200_SCALER_SCALE2X:
+         return 2;
+      case A5200_SCALER_3X:
+      case A5200_SCALER_3X_SCANLINES:
+         return 3;
+      default:
+         break;
+   }
+
+   return 1;
+}
+
+/* Copies a line of 'width' pixels, darkening
+ * each pixel. 'width' must be even, and both
+ * lines must be 32 bit aligned */
+static void scale_darken_line(const uint16_t *in, uint16_t *out, size_t width)
+{
+   const uint32_t *in_ptr = (const uint32_t*)in;
+   uint32_t *out_ptr      = (uint32_t*)out;
+   size_t x;
+
+   for (x = 0; x < (width >> 1); x++)
+      out_ptr[x] = SCALE_DARKEN_PAIR(in_ptr[x]);
+}
+
+/* Fills the remaining (factor - 1) output lines
+ * of the line at 'out', either by copying it or,
+ * for the last line of the group if 'scanlines'
+ * is set, by copying it at reduced brightness */
+static void scale_repeat_line(uint16_t *out, size_t out_width,
+      unsigned factor, bool scanlines)
+{
+   unsigned i;
+
+   for (i = 1; i < factor; i++)
+   {
+      uint16_t *out_line = out + (i * out_width);
+
+      if (scanlines && (i == factor - 1))
+         scale_darken_line(out, out_line, out_width);
+      else
+         memcpy(out_line, out, out_width * sizeof(uint16_t));
+   }
+}
+
+static void scale_nearest_2x(const uint16_t *in, uint16_t *out,
+      size_t width, size_t height, bool scanlines)
+{
+   size_t out_width = width << 1;
+   size_t x, y;
+
+   for (y = 0; y < height; y++)
+   {
+      const uint16_t *in_ptr = in + (y * width);
+      uint32_t *out_ptr      = (uint32_t*)(out + (y * 2 * out_width));
+
+      for (x = 0; x < width; x++)
+         out_ptr[x] = (uint32_t)in_ptr[x] * 0x10001;
+
+      scale_repeat_line((uint16_t*)out_ptr, out_width, 2, scanlines);
+   }
+}
+
+static void scale_nearest_3x(const uint16_t *in, uint16_t *out,
+      size_t width, size_t height, bool scanlines)
+{
+   size_t out_width = width * 3;
+   size_t x, y;
+
+   for (y = 0; y < height; y++)
+   {
+      const uint16_t *in_ptr = in + (y * width);
+      uint16_t *out_line     = out + (y * 3 * out_width);
+      uint16_t *out_ptr      = out_line;
+
+      for (x = 0; x < width; x++)
+      {
+         uint16_t color = in_ptr[x];
+
+         out_ptr[0] = color;
+         out_ptr[1] = color;
+         out_ptr[2] = color;
+         out_ptr   += 3;
+      }
+
+      scale_repeat_line(out_line, out_width, 3, scanlines);
+   }
+}
+
+/* Scale2x (AdvMAME2x/EPX): each pixel E becomes
+ * a 2x2 block, whose corners take the colour of
+ * the adjacent edge pixels where these match,
+ * so diagonal lines are smoothed. Pixels beyond
+ * the image edges repeat the edge pixels */
+static void scale_scale2x(const uint16_t *in, uint16_t *out,
+      size_t width, size_t height)
+{
+   size_t out_width = width << 1;
+   size_t x, y;
+
+   for (y = 0; y < height; y++)
+   {
+      const uint16_t *row  = in + (y * width);
+      const uint16_t *up   = (y > 0) ? row - width : row;
+      const uint16_t *down = (y < height - 1) ? row + width : row;
+      uint16_t *out_a      = out + (y * 2 * out_width);
+      uint16_t *out_b      = out_a + out_width;
+      uint16_t d           = row[0];
+      uint16_t e           = row[0];
+
+      for (x = 0; x < width; x++)
+      {
+         uint16_t b = up[x];
+         uint16_t h = down[x];
+         uint16_t f = (x < width - 1) ? row[x + 1] : e;
+
+         if ((b != h) && (d != f))
+         {
+            out_a[0] = (d == b) ? d : e;
+            out_a[1] = (b == f) ? f : e;
+            out_b[0] = (d == h) ? d : e;
+            out_b[1] = (h == f) ? f : e;
+         }
+         else
+         {
+            out_a[0] = e;
+            out_a[1] = e;
+            out_b[0] = e;
+            out_b[1] = e;
+         }
+
+         out_a += 2;
+         out_b += 2;
+         d      = e;
+         e      = f;
+      }
+   }
+}
+
+void a5200_scale(enum a5200_scaler_type type,
+      const uint16_t *in, uint16_t *out,
+      size_t width, size_t height)
+{
+   switch (type)
+   {
+      case A5200_SCALER_2X:
+         scale_nearest_2x(in, out, width, height, false);
+         break;
+      case A5200_SCALER_2X_SCANLINES:
+         scale_nearest_2x(in, out, width, height, true);
+         break;
+      case A5200_SCALER_3X:
+         scale_nearest_3x(in, out, width, height, false);
+         break;
+      case A5200_SCALER_3X_SCANLINES:
+         scale_nearest_3x(in, out, width, height, true);
+         break;
+      case A5200_SCALER_SCALE2X:
+         scale_scale2x(in, out, width, height);
+         break;
+      default:
+         memcpy(out, in, width * height * sizeof(uint16_t));
+         break;
+   }
+}
@@ -0,0 +1,33 @@
+#ifndef A5200_SCALE_H__
+#define A5200_SCALE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <boolean.h>
+
+enum a5200_scaler_type
+{
+   A5200_SCALER_NONE = 0,
+   A5200_SCALER_2X,
+   A5200_SCALER_3X,
+   A5200_SCALER_2X_SCANLINES,
+   A5200_SCALER_3X_SCANLINES,
+   A5200_SCALER_SCALE2X
+};
+
+/* Largest factor returned by a5200_scale_factor() */
+#define A5200_SCALE_MAX 3
+
+/* Returns the integer scale factor of the
+ * specified scaler (1 for A5200_SCALER_NONE) */
+unsigned a5200_scale_factor(enum a5200_scaler_type type);
+
+/* Scales a 'width' x 'height' RGB565 image,
+ * with a pitch of 'width' pixels. Output pitch
+ * is 'width' multiplied by the scale factor */
+void a5200_scale(enum a5200_scaler_type type,
+      const uint16_t *in, uint16_t *out,
+      size_t width, size_t height);
+
+#endif
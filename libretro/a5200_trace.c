@@ -0,0 +1,157 @@
+#include <stdlib.h>
+
+#include <streams/file_stream.h>
+
+#include "a5200_trace.h"
+
+/* Maximum nesting depth of open spans */
+#define TRACE_MAX_DEPTH 16
+
+typedef struct
+{
+   const char *name;
+   retro_time_t start;
+   retro_time_t duration;
+} trace_span_t;
+
+typedef struct
+{
+   const char *name;
+   retro_time_t start;
+} trace_open_span_t;
+
+static retro_perf_get_time_usec_t trace_get_time_usec = NULL;
+static trace_span_t *trace_ring = NULL;
+static size_t trace_capacity    = 0;
+/* Index of the next span to be written, and
+ * number of valid spans in the ring */
+static size_t trace_head        = 0;
+static size_t trace_count       = 0;
+static trace_open_span_t trace_stack[TRACE_MAX_DEPTH];
+static unsigned trace_depth     = 0;
+/* Spans beyond TRACE_MAX_DEPTH are ignored,
+ * but must still be closed */
+static unsigned trace_overflow  = 0;
+
+bool a5200_trace_init(retro_perf_get_time_usec_t get_time_usec,
+      size_t capacity)
+{
+   a5200_trace_deinit();
+
+   if (!get_time_usec || (capacity < 1))
+      return false;
+
+   trace_ring = (trace_span_t*)malloc(capacity * sizeof(trace_span_t));
+
+   if (!trace_ring)
+      return false;
+
+   trace_get_time_usec = get_time_usec;
+   trace_capacity      = capacity;
+   return true;
+}
+
+void a5200_trace_deinit(void)
+{
+   if (trace_ring)
+      free(trace_ring);
+
+   trace_ring          = NULL;
+   trace_get_time_usec = NULL;
+   trace_capacity      = 0;
+   trace_head          = 0;
+   trace_count         = 0;
+   trace_depth         = 0;
+   trace_overflow      = 0;
+}
+
+bool a5200_trace_enabled(void)
+{
+   return (trace_ring != NULL);
+}
+
+void a5200_trace_begin(const char *name)
+{
+   if (!trace_ring)
+      return;
+
+   if (trace_depth >= TRACE_MAX_DEPTH)
+   {
+      trace_overflow++;
+      return;
+   }
+
+   trace_stack[trace_depth].name  = name;
+   trace_stack[trace_depth].start = trace_get_time_usec();
+   trace_depth++;
+}
+
+void a5200_trace_end(void)
+{
+   trace_span_t *span = NULL;
+
+   if (!trace_ring)
+      return;
+
+   if (trace_overflow > 0)
+   {
+      trace_overflow--;
+      return;
+   }
+
+   if (trace_depth < 1)
+      return;
+
+   trace_depth--;
+
+   span           = &trace_ring[trace_head];
+   span->name     = trace_stack[trace_depth].name;
+   span->start    = trace_stack[trace_depth].start;
+   span->duration = trace_get_time_usec() - span->start;
+
+   trace_head = (trace_head + 1) % trace_capacity;
+   if (trace_count < trace_capacity)
+      trace_count++;
+}
+
+bool a5200_trace_write(const char *path)
+{
+   RFILE *file = NULL;
+   size_t index;
+   size_t i;
+
+   if (!trace_ring || !path)
+      return false;
+
+   file = filestream_open(path,
+         RETRO_VFS_FILE_ACCESS_WRITE,
+         RETRO_VFS_FILE_ACCESS_HINT_NONE);
+
+   if (!file)
+      return false;
+
+   filestream_printf(file, "{\"traceEvents\":[\n");
+
+   /* Oldest span first */
+   index = (trace_head + trace_capacity - trace_count) % trace_capacity;
+
+   for (i = 0; i < trace_count; i++)
+   {
+      const trace_span_t *span = &trace_ring[index];
+
+      filestream_printf(file,
+            "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,"
+            "\"pid\":1,\"tid\":1}%s\n",
+            span->name, (long long)span->start, (long long)span->duration,
+            (i + 1 < trace_count) ? "," : "");
+
+      index = (index + 1) % trace_capacity;
+   }
+
+   filestream_printf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+   filestream_close(file);
+
+   trace_head  = 0;
+   trace_count = 0;
+   return true;
+}
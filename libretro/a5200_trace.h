@@ -0,0 +1,35 @@
+#ifndef A5200_TRACE_H__
+#define A5200_TRACE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <boolean.h>
+#include <libretro.h>
+
+/* Records nested timing spans in a preallocated
+ * ring (the oldest spans are overwritten when it
+ * is full), written out in Chrome trace event
+ * JSON format - viewable in chrome://tracing or
+ * Perfetto. Spans may only be recorded from one
+ * thread. All functions do nothing while the
+ * tracer is not initialised */
+
+/* Allocates a ring of 'capacity' spans, timed
+ * via 'get_time_usec'. Returns false on error */
+bool a5200_trace_init(retro_perf_get_time_usec_t get_time_usec,
+      size_t capacity);
+void a5200_trace_deinit(void);
+bool a5200_trace_enabled(void);
+
+/* 'name' must remain valid until the trace
+ * has been written (i.e. a string literal) */
+void a5200_trace_begin(const char *name);
+/* Closes the innermost open span */
+void a5200_trace_end(void);
+
+/* Writes all recorded spans to 'path' and
+ * empties the ring */
+bool a5200_trace_write(const char *path);
+
+#endif
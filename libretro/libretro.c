@@ -9,6 +9,10 @@
 #include <stdint.h>
 #include <math.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 #ifdef _MSC_VER
 #define snprintf _snprintf
 #endif
@@ -20,14 +24,23 @@
 #include <libretro.h>
 #include "libretro_core_options.h"
 #include "a5200_osk.h"
+#include "a5200_ntsc.h"
+#include "a5200_scale.h"
+#include "a5200_cycle_overlay.h"
+#include "a5200_trace.h"
+#include "a5200_pokey_trace.h"
+#include "a5200_hud.h"
 
 #include "altirra_5200_os.h"
+#include "antic.h"
 #include "atari.h"
 #include "cartridge.h"
 #include "gtia.h"
 #include "input.h"
 #include "pia.h"
+#include "pokey.h"
 #include "pokeysnd.h"
+#include "mzpokeysnd.h"
 #include "statesav.h"
 
 #ifdef _3DS
@@ -42,6 +55,9 @@ static retro_input_state_t input_state_cb;
 static retro_environment_t environ_cb;
 static retro_audio_sample_t audio_cb;
 static retro_audio_sample_batch_t audio_batch_cb;
+static struct retro_perf_callback perf_cb;
+
+void a5200_log(enum retro_log_level level, const char *format, ...);
 
 #ifndef PATH_MAX_LENGTH
 #if defined(_XBOX1) || defined(_3DS) || defined(PSP) || defined(PS2) || defined(GEKKO)|| defined(WIIU) || defined(ORBIS) || defined(__PSL1GHT__) || defined(__PS3__)
@@ -60,20 +76,33 @@ static retro_audio_sample_batch_t audio_batch_cb;
 #define A5200_SAVE_STATE_SIZE 131361
 
 #define A5200_PALETTE_SIZE 256
-#define A5200_SCREEN_BUFFER_WIDTH 512
-#define A5200_SCREEN_BUFFER_HEIGHT 512
+/* Alignment (in bytes) of screen buffer lines */
+#define A5200_SCREEN_BUFFER_ALIGN 64
+/* Threaded video requires a second screen
+ * buffer, so the next frame may be emulated
+ * while the previous one is processed */
+#ifdef HAVE_PTHREAD
+#define A5200_SCREEN_BUFFER_COUNT 2
+#else
+#define A5200_SCREEN_BUFFER_COUNT 1
+#endif
 /* Note: Maximum Atari 5200 resolution is 320x192,
  * but outputting at this resolution causes severe
  * vertical cropping in most games. A vertical
  * display resolution of 224 seems to be the best
- * value for 'safely' cropping overscan */
+ * value for 'safely' cropping overscan.
+ * These are the maximum output dimensions - the
+ * actual output may be cropped further via core
+ * options, in which case only the visible area
+ * is rendered */
 #define A5200_VIDEO_WIDTH 320
 #define A5200_VIDEO_HEIGHT 224
-#define A5200_VIDEO_OFFSET_X ((ATARI_WIDTH - A5200_VIDEO_WIDTH) >> 1)
-#define A5200_VIDEO_OFFSET_Y ((ATARI_HEIGHT - A5200_VIDEO_HEIGHT) >> 1)
 
 #define A5200_FPS 60
-#define A5200_AUDIO_BUFFER_SIZE (SOUND_SAMPLE_RATE / A5200_FPS)
+#define A5200_SAMPLE_RATE_MIN 8000
+#define A5200_SAMPLE_RATE_MAX 48000
+/* Largest number of samples generated per frame */
+#define A5200_AUDIO_BUFFER_SIZE ((A5200_SAMPLE_RATE_MAX / A5200_FPS) + 1)
 
 #define LIBRETRO_ANALOG_RANGE 0x8000
 #define A5200_JOY_MIN 6
@@ -171,14 +200,64 @@ static const unsigned input_analog_numpad_map[8] = {
 };
 
 uint8_t *a5200_screen_buffer         = NULL;
+static uint8_t *screen_buffer_raw    = NULL;
+static uint8_t *screen_buffers[A5200_SCREEN_BUFFER_COUNT] = {NULL};
 static uint16_t *video_buffer        = NULL;
 static uint16_t *video_buffer_prev   = NULL;
-static uint8_t *audio_samples_buffer = NULL;
+#ifndef SYNCHRONIZED_SOUND
 static int16_t *audio_out_buffer     = NULL;
+#endif
+
+static unsigned video_width         = A5200_VIDEO_WIDTH;
+static unsigned video_height        = A5200_VIDEO_HEIGHT;
+/* In half width mode, one output pixel is
+ * generated per colour clock */
+static bool video_half_width        = false;
+static unsigned video_out_width     = A5200_VIDEO_WIDTH;
+static bool update_geometry         = false;
+/* Set when the 'NTSC composite' artifacting
+ * mode is selected */
+static bool video_composite         = false;
+/* Selected artifacting - may be overridden
+ * by the quality governor */
+static int video_artif_mode         = 0;
+static bool video_artif_composite   = false;
+static enum a5200_scaler_type video_scaler = A5200_SCALER_NONE;
+/* Set when the per-scanline cycle
+ * overlay is shown */
+static bool video_cycle_overlay     = false;
+/* Set when the performance HUD is shown */
+static bool video_perf_hud          = false;
+static a5200_hud_stats_t hud_stats;
 
 static bool audio_low_pass_enabled  = false;
 static int32_t audio_low_pass_range = (60 * 0x10000) / 100;
-static int32_t audio_low_pass_prev  = 0;
+/* Selected sample rate - applied to the emulated
+ * sound (sound_sample_rate) in retro_run() */
+static unsigned audio_sample_rate   = SOUND_SAMPLE_RATE;
+#ifndef SYNCHRONIZED_SOUND
+/* The number of samples per frame may be
+ * fractional: the remainder (in 1/A5200_FPS
+ * samples) is carried over to the next frame */
+static unsigned audio_samples_remainder = 0;
+#endif
+/* Selected sound engine and threading - the
+ * engine may be overridden by the quality
+ * governor */
+static bool audio_new_pokey         = true;
+static bool audio_thread_enabled    = false;
+/* The engines have different DC offsets. When
+ * the engine is switched, the step between the
+ * mean levels of the last frame of the old
+ * engine and the first frame of the new one is
+ * faded out over A5200_DECLICK_FRAMES frames,
+ * so the switch does not pop */
+#define A5200_DECLICK_FRAMES 4
+static int32_t audio_frame_level[2]   = {0};
+static int32_t audio_declick_step[2]  = {0};
+static unsigned audio_declick_pos     = 0;
+static unsigned audio_declick_length  = 0;
+static bool audio_declick             = false;
 
 enum input_hack_type
 {
@@ -220,6 +299,7 @@ static bool libretro_supports_bitmasks = false;
 extern UBYTE PCPOT_input[8];
 extern void ANTIC_UpdateArtifacting(void);
 extern int global_artif_mode;
+extern int antic_skip_render;
 
 static int min(int a, int b)
 {
@@ -255,13 +335,13 @@ enum frame_blend_method
  * performance by ~15% */
 #define BLEND_FRAMES_GHOST(persistence)                                                               \
 {                                                                                                     \
-   uint16_t *curr = video_buffer;                                                                     \
+   uint16_t *curr = buffer;                                                                           \
    uint16_t *prev = video_buffer_prev;                                                                \
    size_t x, y;                                                                                       \
                                                                                                       \
-   for (y = 0; y < A5200_VIDEO_HEIGHT; y++)                                                           \
+   for (y = 0; y < video_height; y++)                                                                 \
    {                                                                                                  \
-      for (x = 0; x < A5200_VIDEO_WIDTH; x++)                                                         \
+      for (x = 0; x < video_out_width; x++)                                                           \
       {                                                                                               \
          /* Get colours from current + previous frames */                                             \
          uint16_t color_curr = *(curr);                                                               \
@@ -295,15 +375,15 @@ enum frame_blend_method
    }                                                                                                  \
 }
 
-static void blend_frames_mix(void)
+static void blend_frames_mix(uint16_t *buffer)
 {
-   uint16_t *curr = video_buffer;
+   uint16_t *curr = buffer;
    uint16_t *prev = video_buffer_prev;
    size_t x, y;
 
-   for (y = 0; y < A5200_VIDEO_HEIGHT; y++)
+   for (y = 0; y < video_height; y++)
    {
-      for (x = 0; x < A5200_VIDEO_WIDTH; x++)
+      for (x = 0; x < video_out_width; x++)
       {
          /* Get colours from current + previous frames */
          uint16_t color_curr = *(curr);
@@ -318,67 +398,1139 @@ static void blend_frames_mix(void)
    }
 }
 
-static void blend_frames_ghost65(void)
+static void blend_frames_ghost65(uint16_t *buffer)
 {
    /* 65% = 83 / 128 */
    BLEND_FRAMES_GHOST(83);
 }
 
-static void blend_frames_ghost75(void)
+static void blend_frames_ghost75(uint16_t *buffer)
 {
    /* 75% = 95 / 128 */
    BLEND_FRAMES_GHOST(95);
 }
 
-static void blend_frames_ghost85(void)
-{
-   /* 85% ~= 109 / 128 */
-   BLEND_FRAMES_GHOST(109);
+static void blend_frames_ghost85(uint16_t *buffer)
+{
+   /* 85% ~= 109 / 128 */
+   BLEND_FRAMES_GHOST(109);
+}
+
+static void blend_frames_ghost95(uint16_t *buffer)
+{
+   /* 95% ~= 122 / 128 */
+   BLEND_FRAMES_GHOST(122);
+}
+
+static void (*blend_frames)(uint16_t *buffer) = NULL;
+/* Selected blending method - may be overridden
+ * by the quality governor */
+static enum frame_blend_method frame_blend_method = FRAME_BLEND_NONE;
+/* Set when blending is (re)enabled: the next
+ * frame is then blended with itself, rather
+ * than with a blank or stale frame */
+static bool blend_frames_seed = false;
+
+static void init_frame_blending(enum frame_blend_method blend_method)
+{
+   /* Allocate/zero out buffer, if required */
+   if (blend_method != FRAME_BLEND_NONE)
+   {
+      if (!video_buffer_prev)
+         video_buffer_prev = (uint16_t*)malloc(A5200_VIDEO_WIDTH *
+               A5200_VIDEO_HEIGHT * sizeof(uint16_t));
+
+      memset(video_buffer_prev, 0, A5200_VIDEO_WIDTH *
+            A5200_VIDEO_HEIGHT * sizeof(uint16_t));
+      blend_frames_seed = true;
+   }
+
+   /* Assign function pointer */
+   switch (blend_method)
+   {
+      case FRAME_BLEND_MIX:
+         blend_frames = blend_frames_mix;
+         break;
+      case FRAME_BLEND_GHOST_65:
+         blend_frames = blend_frames_ghost65;
+         break;
+      case FRAME_BLEND_GHOST_75:
+         blend_frames = blend_frames_ghost75;
+         break;
+      case FRAME_BLEND_GHOST_85:
+         blend_frames = blend_frames_ghost85;
+         break;
+      case FRAME_BLEND_GHOST_95:
+         blend_frames = blend_frames_ghost95;
+         break;
+      default:
+         blend_frames = NULL;
+         break;
+   }
+}
+
+/************************************
+ * Render window
+ ************************************/
+
+/* (Re)allocates the screen buffer for the
+ * current crop settings, and restricts
+ * ANTIC rendering to the visible area */
+static void init_render_window(void)
+{
+   size_t size = (ANTIC_SCREEN_BUFFER_SIZE(video_height) +
+         A5200_SCREEN_BUFFER_ALIGN - 1) &
+               ~(size_t)(A5200_SCREEN_BUFFER_ALIGN - 1);
+   size_t i;
+
+   if (screen_buffer_raw)
+      free(screen_buffer_raw);
+
+   screen_buffer_raw = (uint8_t*)malloc((size * A5200_SCREEN_BUFFER_COUNT) +
+         A5200_SCREEN_BUFFER_ALIGN - 1);
+   screen_buffers[0] = (uint8_t*)(((uintptr_t)screen_buffer_raw +
+         A5200_SCREEN_BUFFER_ALIGN - 1) &
+               ~(uintptr_t)(A5200_SCREEN_BUFFER_ALIGN - 1));
+   memset(screen_buffers[0], 0, size * A5200_SCREEN_BUFFER_COUNT);
+
+   for (i = 1; i < A5200_SCREEN_BUFFER_COUNT; i++)
+      screen_buffers[i] = screen_buffers[i - 1] + size;
+
+   a5200_screen_buffer = screen_buffers[0];
+
+   ANTIC_SetRenderWindow((ATARI_WIDTH - video_width) >> 1,
+         (ATARI_HEIGHT - video_height) >> 1,
+         video_width, video_height);
+}
+
+/************************************
+ * Video post-processing
+ ************************************/
+
+/* Converts the render window of the specified
+ * screen buffer to RGB565 via the palette */
+static void render_video_palette(const uint8_t *screen_buffer, uint16_t *buffer)
+{
+   uint16_t *video_buffer_ptr = buffer;
+   size_t x, y;
+
+   for (y = 0; y < video_height; y++)
+   {
+      const uint8_t *screen_buffer_ptr = screen_buffer +
+            ((y + 1) * ANTIC_SCREEN_PITCH) +
+            ((ATARI_WIDTH - video_width) >> 1);
+
+      if (video_half_width)
+      {
+         /* Colour clocks are two identical pixels wide,
+          * except in hi-res modes 2, 3 and F - in that
+          * case, the two pixels are averaged */
+         for (x = 0; x < video_out_width; x++)
+         {
+            uint8_t color_l  = *(screen_buffer_ptr++);
+            uint8_t color_r  = *(screen_buffer_ptr++);
+            uint16_t rgb_out = a5200_palette_rgb565[color_l];
+
+            if (color_r != color_l)
+            {
+               uint16_t rgb_r = a5200_palette_rgb565[color_r];
+               rgb_out = (rgb_out + rgb_r + ((rgb_out ^ rgb_r) & 0x821)) >> 1;
+            }
+
+            *(video_buffer_ptr++) = rgb_out;
+         }
+      }
+      else
+         for (x = 0; x < video_width; x++)
+            *(video_buffer_ptr++) = a5200_palette_rgb565[*(screen_buffer_ptr + x)];
+   }
+}
+
+/* Converts the render window of the specified
+ * screen buffer to RGB565 and applies frame
+ * blending */
+static void render_video(const uint8_t *screen_buffer, uint16_t *buffer)
+{
+   /* Line 0 of the screen buffer is the ANTIC
+    * scratch line - the render window follows */
+   if (video_composite)
+      a5200_ntsc_blit(screen_buffer + ANTIC_SCREEN_PITCH +
+                  ((ATARI_WIDTH - video_width) >> 1),
+            ANTIC_SCREEN_PITCH, buffer, video_out_width,
+            video_width, video_height, video_half_width);
+   else
+      render_video_palette(screen_buffer, buffer);
+
+   if (blend_frames)
+   {
+      if (blend_frames_seed)
+      {
+         memcpy(video_buffer_prev, buffer, video_out_width *
+               video_height * sizeof(uint16_t));
+         blend_frames_seed = false;
+      }
+
+      blend_frames(buffer);
+   }
+}
+
+/************************************
+ * Integer scaling
+ ************************************/
+
+/* Scaled copies of video_buffer and, when
+ * threaded video is used, video_buffer_alt */
+static uint16_t *video_buffer_scaled[2] = {NULL};
+
+/* Set if the frontend accepts NULL (dupe) frames */
+static bool video_can_dupe = false;
+
+/* Frame last passed to the frontend, presented
+ * again in place of a dupe when video_can_dupe
+ * is not set */
+static const uint16_t *video_last_buffer = NULL;
+static unsigned video_last_width         = 0;
+static unsigned video_last_height        = 0;
+
+static uint16_t *get_scaled_buffer(const uint16_t *buffer)
+{
+   return video_buffer_scaled[(buffer == video_buffer) ? 0 : 1];
+}
+
+/* Allocates the scaled output buffers, if
+ * required. Returns false on failure */
+static bool init_video_scaler(void)
+{
+   size_t size = A5200_VIDEO_WIDTH * A5200_VIDEO_HEIGHT *
+         A5200_SCALE_MAX * A5200_SCALE_MAX * sizeof(uint16_t);
+   size_t i;
+
+   for (i = 0; i < 2; i++)
+   {
+      if (video_buffer_scaled[i])
+         continue;
+
+      video_buffer_scaled[i] = (uint16_t*)malloc(size);
+      if (!video_buffer_scaled[i])
+         return false;
+
+      memset(video_buffer_scaled[i], 0, size);
+   }
+
+   return true;
+}
+
+static void deinit_video_scaler(void)
+{
+   size_t i;
+
+   for (i = 0; i < 2; i++)
+   {
+      if (video_buffer_scaled[i])
+      {
+         free(video_buffer_scaled[i]);
+         video_buffer_scaled[i] = NULL;
+      }
+   }
+}
+
+/* Outputs the specified 'width' x 'height' frame
+ * via 'scaler'. If 'scaled' is set, the scaled copy
+ * of the frame is already up to date */
+static void output_video(uint16_t *buffer, unsigned width, unsigned height,
+      enum a5200_scaler_type scaler, bool scaled)
+{
+   unsigned factor = a5200_scale_factor(scaler);
+
+   if (factor > 1)
+   {
+      uint16_t *scaled_buffer = get_scaled_buffer(buffer);
+
+      if (!scaled)
+         a5200_scale(scaler, buffer, scaled_buffer, width, height);
+
+      buffer  = scaled_buffer;
+      width  *= factor;
+      height *= factor;
+   }
+
+   video_cb(buffer, width, height, width << 1);
+
+   video_last_buffer = buffer;
+   video_last_width  = width;
+   video_last_height = height;
+}
+
+/* Signals a dupe frame to the frontend. If the
+ * frontend cannot dupe, the last frame is passed
+ * again - its buffer is not written until the
+ * next frame is rendered */
+static void output_video_dupe(void)
+{
+   if (video_can_dupe)
+   {
+      unsigned factor = a5200_scale_factor(video_scaler);
+      unsigned width  = video_out_width * factor;
+
+      video_cb(NULL, width, video_height * factor, width << 1);
+   }
+   else if (video_last_buffer)
+      video_cb(video_last_buffer, video_last_width, video_last_height,
+            video_last_width << 1);
+   else
+      output_video(video_buffer, video_out_width, video_height,
+            video_scaler, false);
+}
+
+/* Draws the per-scanline cycle usage of a frame
+ * over the 'width' x 'height' frame in 'buffer' */
+static void draw_cycle_overlay(uint16_t *buffer, unsigned width,
+      unsigned height, const ANTIC_line_stat *stats)
+{
+   int lines;
+
+   ANTIC_GetLineStats(&lines);
+
+   /* Scanline 8 is the first line of
+    * the ATARI_HEIGHT screen */
+   a5200_cycle_overlay_draw(buffer, width, height, video_half_width,
+         stats, lines, 8 + ((ATARI_HEIGHT - (int)height) >> 1));
+}
+
+/* Draws the performance HUD, if enabled */
+static void draw_perf_hud(uint16_t *buffer, unsigned width,
+      unsigned height)
+{
+   if (video_perf_hud)
+      a5200_hud_draw(buffer, width, height, &hud_stats);
+}
+
+/************************************
+ * Threaded video
+ ************************************/
+
+#ifdef HAVE_PTHREAD
+/* When enabled, post-processing of frame N is
+ * performed on a worker thread while frame N+1
+ * is emulated. Frame N is then presented after
+ * frame N+1 has been emulated, i.e. there is one
+ * frame of additional latency. Everything the
+ * worker reads (screen buffer contents, crop,
+ * blending state) is only modified by the main
+ * thread once the worker is idle */
+static bool video_thread_enabled     = false;
+static bool video_thread_running     = false;
+static bool video_thread_busy        = false;
+static bool video_thread_quit        = false;
+static bool video_thread_frame_ready = false;
+static pthread_t video_thread;
+static pthread_mutex_t video_thread_mutex;
+static pthread_cond_t video_thread_cond;
+static const uint8_t *video_thread_screen_buffer = NULL;
+static uint16_t *video_thread_buffer             = NULL;
+static unsigned video_thread_width               = 0;
+static unsigned video_thread_height              = 0;
+static enum a5200_scaler_type video_thread_scaler = A5200_SCALER_NONE;
+static bool video_thread_cycle_overlay           = false;
+/* Line statistics of the submitted frame, since
+ * ANTIC_line_stats is overwritten by the next one */
+static ANTIC_line_stat video_thread_line_stats[ANTIC_LINE_STATS_MAX];
+/* Worker output alternates between video_buffer
+ * and video_buffer_alt, so the frame last passed
+ * to the frontend is never overwritten */
+static uint16_t *video_buffer_alt                = NULL;
+
+static void *video_thread_loop(void *data)
+{
+   (void)data;
+
+   pthread_mutex_lock(&video_thread_mutex);
+
+   for (;;)
+   {
+      while (!video_thread_busy && !video_thread_quit)
+         pthread_cond_wait(&video_thread_cond, &video_thread_mutex);
+
+      if (video_thread_quit)
+         break;
+
+      pthread_mutex_unlock(&video_thread_mutex);
+      render_video(video_thread_screen_buffer, video_thread_buffer);
+      if (video_thread_scaler != A5200_SCALER_NONE)
+         a5200_scale(video_thread_scaler, video_thread_buffer,
+               get_scaled_buffer(video_thread_buffer),
+               video_thread_width, video_thread_height);
+      pthread_mutex_lock(&video_thread_mutex);
+
+      video_thread_busy = false;
+      pthread_cond_broadcast(&video_thread_cond);
+   }
+
+   pthread_mutex_unlock(&video_thread_mutex);
+   return NULL;
+}
+
+/* Blocks until the worker has finished
+ * processing the last submitted frame */
+static void video_thread_wait(void)
+{
+   if (!video_thread_running)
+      return;
+
+   pthread_mutex_lock(&video_thread_mutex);
+   while (video_thread_busy)
+      pthread_cond_wait(&video_thread_cond, &video_thread_mutex);
+   pthread_mutex_unlock(&video_thread_mutex);
+}
+
+/* Hands the frame just emulated to the worker,
+ * and switches emulation to the other screen
+ * buffer */
+static void video_thread_submit(void)
+{
+   uint16_t *buffer = (video_thread_buffer == video_buffer) ?
+         video_buffer_alt : video_buffer;
+
+   pthread_mutex_lock(&video_thread_mutex);
+   video_thread_screen_buffer = a5200_screen_buffer;
+   video_thread_buffer        = buffer;
+   video_thread_width         = video_out_width;
+   video_thread_height        = video_height;
+   video_thread_scaler        = video_scaler;
+   video_thread_cycle_overlay = video_cycle_overlay;
+   video_thread_busy          = true;
+   video_thread_frame_ready   = true;
+   pthread_cond_broadcast(&video_thread_cond);
+   pthread_mutex_unlock(&video_thread_mutex);
+
+   if (video_cycle_overlay)
+      memcpy(video_thread_line_stats, ANTIC_line_stats,
+            sizeof(video_thread_line_stats));
+
+   a5200_screen_buffer = (a5200_screen_buffer == screen_buffers[0]) ?
+         screen_buffers[1] : screen_buffers[0];
+}
+
+/* Outputs the last frame processed by the worker.
+ * The OSK, cycle overlay and HUD are drawn here
+ * rather than by the worker, since their state is
+ * updated by the main thread while the worker
+ * runs - the frame must then be scaled again */
+static void video_thread_present(void)
+{
+   video_thread_wait();
+
+   if (video_thread_frame_ready)
+   {
+      if (video_thread_cycle_overlay)
+         draw_cycle_overlay(video_thread_buffer, video_thread_width,
+               video_thread_height, video_thread_line_stats);
+
+      draw_perf_hud(video_thread_buffer, video_thread_width,
+            video_thread_height);
+
+      if (input_show_osk)
+         a5200_osk_draw(video_thread_buffer, video_thread_width,
+               video_thread_height, video_half_width);
+
+      output_video(video_thread_buffer, video_thread_width,
+            video_thread_height, video_thread_scaler,
+            !input_show_osk && !video_thread_cycle_overlay &&
+            !video_perf_hud);
+      video_thread_frame_ready = false;
+   }
+   else
+      output_video_dupe();
+}
+
+static void init_video_thread(void)
+{
+   if (video_thread_running)
+      return;
+
+   if (!video_buffer_alt)
+   {
+#ifdef _3DS
+      video_buffer_alt = (uint16_t*)linearMemAlign(A5200_VIDEO_WIDTH *
+            A5200_VIDEO_HEIGHT * sizeof(uint16_t), 128);
+#else
+      video_buffer_alt = (uint16_t*)malloc(A5200_VIDEO_WIDTH *
+            A5200_VIDEO_HEIGHT * sizeof(uint16_t));
+#endif
+      if (!video_buffer_alt)
+         return;
+   }
+
+   video_thread_busy          = false;
+   video_thread_quit          = false;
+   video_thread_frame_ready   = false;
+   video_thread_screen_buffer = NULL;
+   video_thread_buffer        = NULL;
+
+   pthread_mutex_init(&video_thread_mutex, NULL);
+   pthread_cond_init(&video_thread_cond, NULL);
+
+   if (pthread_create(&video_thread, NULL, video_thread_loop, NULL) != 0)
+   {
+      a5200_log(RETRO_LOG_WARN,
+            "Threaded video disabled - failed to create worker thread.\n");
+      pthread_cond_destroy(&video_thread_cond);
+      pthread_mutex_destroy(&video_thread_mutex);
+      return;
+   }
+
+   video_thread_running = true;
+}
+
+static void deinit_video_thread(void)
+{
+   if (!video_thread_running)
+      return;
+
+   video_thread_wait();
+
+   pthread_mutex_lock(&video_thread_mutex);
+   video_thread_quit = true;
+   pthread_cond_broadcast(&video_thread_cond);
+   pthread_mutex_unlock(&video_thread_mutex);
+
+   pthread_join(video_thread, NULL);
+   pthread_cond_destroy(&video_thread_cond);
+   pthread_mutex_destroy(&video_thread_mutex);
+
+   video_thread_running     = false;
+   video_thread_frame_ready = false;
+}
+#endif
+
+/************************************
+ * Frameskipping
+ ************************************/
+
+enum frameskip_type
+{
+   FRAMESKIP_NONE = 0,
+   FRAMESKIP_AUTO,
+   FRAMESKIP_MANUAL,
+   FRAMESKIP_FIXED
+};
+
+/* Maximum number of consecutive frames that
+ * may be skipped when frameskipping is driven
+ * by the frontend audio buffer status */
+#define A5200_FRAMESKIP_MAX 30
+
+static enum frameskip_type frameskip_type = FRAMESKIP_NONE;
+static unsigned frameskip_threshold       = 0;
+static unsigned frameskip_interval        = 1;
+static unsigned frameskip_counter         = 0;
+/* Set by the quality governor - every other
+ * frame is then skipped, in addition to any
+ * frames skipped by the selected method */
+static bool frameskip_governor            = false;
+static bool frameskip_governor_skip       = false;
+
+static bool retro_audio_buff_active        = false;
+static unsigned retro_audio_buff_occupancy = 0;
+static bool retro_audio_buff_underrun      = false;
+
+static unsigned audio_latency     = 0;
+static bool update_audio_latency  = false;
+
+static void retro_audio_buff_status_cb(
+      bool active, unsigned occupancy, bool underrun_likely)
+{
+   retro_audio_buff_active    = active;
+   retro_audio_buff_occupancy = occupancy;
+   retro_audio_buff_underrun  = underrun_likely;
+}
+
+static void init_frameskip(void)
+{
+   bool buff_status_required = (frameskip_type == FRAMESKIP_AUTO) ||
+                               (frameskip_type == FRAMESKIP_MANUAL);
+
+   /* The performance HUD also shows the
+    * audio buffer status, but does not
+    * require an increased latency */
+   if (buff_status_required || video_perf_hud)
+   {
+      struct retro_audio_buffer_status_callback buf_status_cb;
+
+      buf_status_cb.callback = retro_audio_buff_status_cb;
+      if (!environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK,
+            &buf_status_cb))
+      {
+         if (buff_status_required)
+            a5200_log(RETRO_LOG_WARN,
+                  "Frameskip disabled - frontend does not support audio buffer status monitoring.\n");
+
+         retro_audio_buff_active    = false;
+         retro_audio_buff_occupancy = 0;
+         retro_audio_buff_underrun  = false;
+         audio_latency              = 0;
+      }
+      else if (!buff_status_required)
+         audio_latency = 0;
+      else
+      {
+         /* Frameskip is enabled - increase frontend
+          * audio latency to minimise potential
+          * buffer underruns */
+         float frame_time_msec = 1000.0f / (float)A5200_FPS;
+
+         /* Set latency to 6x current frame time... */
+         audio_latency = (unsigned)((6.0f * frame_time_msec) + 0.5f);
+
+         /* ...then round up to nearest multiple of 32 */
+         audio_latency = (audio_latency + 0x1F) & ~0x1F;
+      }
+   }
+   else
+   {
+      environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK, NULL);
+      audio_latency = 0;
+   }
+
+   frameskip_counter    = 0;
+   update_audio_latency = true;
+}
+
+/* Returns true if the next frame should be
+ * emulated without generating any video output */
+static bool frameskip_check(void)
+{
+   bool skip_frame = false;
+
+   if (frameskip_governor)
+   {
+      frameskip_governor_skip = !frameskip_governor_skip;
+      if (frameskip_governor_skip)
+         return true;
+   }
+
+   switch (frameskip_type)
+   {
+      case FRAMESKIP_AUTO:
+         skip_frame = retro_audio_buff_active &&
+               retro_audio_buff_underrun;
+         break;
+      case FRAMESKIP_MANUAL:
+         skip_frame = retro_audio_buff_active &&
+               (retro_audio_buff_occupancy < frameskip_threshold);
+         break;
+      case FRAMESKIP_FIXED:
+         /* Display one frame, then skip
+          * 'frameskip_interval' frames */
+         skip_frame        = (frameskip_counter > 0);
+         frameskip_counter = (frameskip_counter < frameskip_interval) ?
+               frameskip_counter + 1 : 0;
+         return skip_frame;
+      default:
+         return false;
+   }
+
+   /* Never skip more than A5200_FRAMESKIP_MAX
+    * frames in a row, otherwise the display
+    * could freeze indefinitely */
+   if (skip_frame)
+   {
+      if (frameskip_counter < A5200_FRAMESKIP_MAX)
+         frameskip_counter++;
+      else
+      {
+         frameskip_counter = 0;
+         skip_frame        = false;
+      }
+   }
+   else
+      frameskip_counter = 0;
+
+   return skip_frame;
+}
+
+/************************************
+ * Tracing
+ ************************************/
+
+/* Number of spans held by the trace ring:
+ * about one minute of frames */
+#define A5200_TRACE_CAPACITY (1 << 16)
+#define A5200_TRACE_FILE_NAME "a5200_trace.json"
+
+/* ANTIC_Frame is traced in bands of
+ * ANTIC_TRACE_BAND_LINES (32) scanlines */
+static const char *const trace_band_names[] = {
+   "GO lines 0-31",    "GO lines 32-63",   "GO lines 64-95",
+   "GO lines 96-127",  "GO lines 128-159", "GO lines 160-191",
+   "GO lines 192-223", "GO lines 224-255", "GO lines 256-287",
+   "GO lines 288-319"
+};
+
+static void trace_antic_band(int ypos)
+{
+   int band = ypos / ANTIC_TRACE_BAND_LINES;
+
+   if (ypos == 0)
+      a5200_trace_begin("ANTIC_Frame");
+   else
+      a5200_trace_end();
+
+   if (ypos >= max_ypos)
+      a5200_trace_end();
+   else if (band < (int)(sizeof(trace_band_names) / sizeof(trace_band_names[0])))
+      a5200_trace_begin(trace_band_names[band]);
+   else
+      a5200_trace_begin("GO");
+}
+
+/* Gets the path of the trace file 'name' in the
+ * save directory (or system directory, if the
+ * frontend does not provide one) */
+static bool get_trace_path(const char *name, char *path, size_t size)
+{
+   const char *dir = NULL;
+
+   path[0] = '\0';
+
+   if ((!environ_cb(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY, &dir) || !dir) &&
+       (!environ_cb(RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY, &dir) || !dir))
+   {
+      a5200_log(RETRO_LOG_WARN,
+            "No save directory defined, unable to write trace.\n");
+      return false;
+   }
+
+   fill_pathname_join(path, dir, name, size);
+   return true;
+}
+
+/* Writes the recorded trace */
+static void write_trace(void)
+{
+   char trace_path[PATH_MAX_LENGTH];
+
+   if (!a5200_trace_enabled() ||
+       !get_trace_path(A5200_TRACE_FILE_NAME, trace_path,
+            sizeof(trace_path)))
+      return;
+
+   if (a5200_trace_write(trace_path))
+      a5200_log(RETRO_LOG_INFO, "Trace written to: %s\n", trace_path);
+   else
+      a5200_log(RETRO_LOG_ERROR,
+            "Failed to write trace file: %s\n", trace_path);
+}
+
+static void init_trace(void)
+{
+   if (a5200_trace_enabled())
+      return;
+
+   if (!perf_cb.get_time_usec ||
+       !a5200_trace_init(perf_cb.get_time_usec, A5200_TRACE_CAPACITY))
+   {
+      a5200_log(RETRO_LOG_WARN,
+            "Tracing disabled - no timer available or failed to allocate buffer.\n");
+      return;
+   }
+
+   antic_trace_hook = trace_antic_band;
+}
+
+static void deinit_trace(void)
+{
+   write_trace();
+   a5200_trace_deinit();
+   antic_trace_hook = NULL;
+}
+
+/************************************
+ * POKEY register trace
+ ************************************/
+
+#define A5200_POKEY_TRACE_FILE_NAME "a5200_pokey.trace"
+
+static void record_pokey_write(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain)
+{
+   a5200_pokey_trace_write(cpu_clock, chip, addr & 0x0F, val, gain);
+}
+
+static void init_pokey_trace(void)
+{
+   char trace_path[PATH_MAX_LENGTH];
+
+   if (a5200_pokey_trace_active() ||
+       !get_trace_path(A5200_POKEY_TRACE_FILE_NAME, trace_path,
+            sizeof(trace_path)))
+      return;
+
+   if (!a5200_pokey_trace_open(trace_path, A5200_FPS * 1000,
+            (uint16_t)tv_mode))
+   {
+      a5200_log(RETRO_LOG_ERROR,
+            "Failed to create POKEY trace file: %s\n", trace_path);
+      return;
+   }
+
+   /* The trace starts from the current
+    * register values */
+   POKEY_ReplaySoundRegisters(record_pokey_write);
+   POKEYSND_trace_hook = record_pokey_write;
+
+   a5200_log(RETRO_LOG_INFO, "Recording POKEY trace to: %s\n", trace_path);
+}
+
+static void deinit_pokey_trace(void)
+{
+   POKEYSND_trace_hook = NULL;
+   a5200_pokey_trace_close();
+}
+
+/************************************
+ * Performance HUD
+ ************************************/
+
+/* Number of frames averaged by each
+ * update of the HUD */
+#define A5200_HUD_INTERVAL 30
+
+static retro_time_t hud_emulation_time = 0;
+static retro_time_t hud_video_time     = 0;
+static retro_time_t hud_audio_time     = 0;
+static uint32_t hud_cpu_cycles         = 0;
+static uint32_t hud_dma_cycles         = 0;
+static uint32_t hud_wsync_cycles       = 0;
+static uint32_t hud_total_cycles       = 0;
+static unsigned hud_frames             = 0;
+static unsigned hud_frames_skipped     = 0;
+
+static retro_time_t hud_get_time(void)
+{
+   return perf_cb.get_time_usec ? perf_cb.get_time_usec() : 0;
+}
+
+static const char *hud_frameskip_mode(void)
+{
+   switch (frameskip_type)
+   {
+      case FRAMESKIP_AUTO:
+         return "AUTO";
+      case FRAMESKIP_MANUAL:
+         return "MANUAL";
+      case FRAMESKIP_FIXED:
+         return "FIXED";
+      default:
+         break;
+   }
+
+   return "OFF";
+}
+
+static void reset_perf_hud(void)
+{
+   memset(&hud_stats, 0, sizeof(hud_stats));
+   hud_stats.emulation_usec         = -1;
+   hud_stats.video_usec             = -1;
+   hud_stats.audio_usec             = -1;
+   hud_stats.audio_buffer_occupancy = -1;
+
+   hud_emulation_time = 0;
+   hud_video_time     = 0;
+   hud_audio_time     = 0;
+   hud_cpu_cycles     = 0;
+   hud_dma_cycles     = 0;
+   hud_wsync_cycles   = 0;
+   hud_total_cycles   = 0;
+   hud_frames         = 0;
+   hud_frames_skipped = 0;
+}
+
+/* Adds the frame just output to the HUD
+ * statistics, given the host time spent on
+ * each of its phases */
+static void update_perf_hud(retro_time_t emulation_time,
+      retro_time_t video_time, retro_time_t audio_time, bool skipped)
+{
+   const ANTIC_line_stat *line_stats;
+   int lines;
+   int i;
+
+   hud_emulation_time += emulation_time;
+   hud_video_time     += video_time;
+   hud_audio_time     += audio_time;
+
+   line_stats = ANTIC_GetLineStats(&lines);
+   for (i = 0; i < lines; i++)
+   {
+      hud_cpu_cycles   += line_stats[i].cpu_cycles;
+      hud_dma_cycles   += line_stats[i].dma_cycles;
+      hud_wsync_cycles += line_stats[i].wsync_cycles;
+   }
+   hud_total_cycles += lines * LINE_C;
+
+   hud_frames++;
+   if (skipped)
+      hud_frames_skipped++;
+
+   if (hud_frames < A5200_HUD_INTERVAL)
+      return;
+
+   if (perf_cb.get_time_usec)
+   {
+      hud_stats.emulation_usec = (int)(hud_emulation_time / hud_frames);
+      hud_stats.video_usec     = (int)(hud_video_time / hud_frames);
+      hud_stats.audio_usec     = (int)(hud_audio_time / hud_frames);
+   }
+
+   hud_stats.cpu_percent    = (hud_cpu_cycles * 100) / hud_total_cycles;
+   hud_stats.dma_percent    = (hud_dma_cycles * 100) / hud_total_cycles;
+   hud_stats.wsync_percent  = (hud_wsync_cycles * 100) / hud_total_cycles;
+   hud_stats.frameskip_mode = hud_frameskip_mode();
+   hud_stats.frames_skipped = hud_frames_skipped;
+   hud_stats.frames         = hud_frames;
+   hud_stats.audio_buffer_occupancy = retro_audio_buff_active ?
+         (int)retro_audio_buff_occupancy : -1;
+
+   hud_emulation_time = 0;
+   hud_video_time     = 0;
+   hud_audio_time     = 0;
+   hud_cpu_cycles     = 0;
+   hud_dma_cycles     = 0;
+   hud_wsync_cycles   = 0;
+   hud_total_cycles   = 0;
+   hud_frames         = 0;
+   hud_frames_skipped = 0;
+}
+
+/************************************
+ * Quality governor
+ ************************************/
+
+/* Features that are stepped down, in this
+ * order, while the host time taken by each
+ * frame exceeds the threshold, and restored
+ * (in reverse order) once there is headroom */
+enum governor_step
+{
+   GOVERNOR_STEP_BLENDING = 0,
+   GOVERNOR_STEP_ARTIFACTING,
+   GOVERNOR_STEP_POKEY,
+   GOVERNOR_STEP_FRAMESKIP,
+   GOVERNOR_STEP_COUNT
+};
+
+static const char *const governor_step_names[GOVERNOR_STEP_COUNT] = {
+   "interframe blending",
+   "artifacting",
+   "High Fidelity POKEY",
+   "full frame rate"
+};
+
+/* Number of displayed frames over which
+ * the frame time is averaged */
+#define A5200_GOVERNOR_INTERVAL 60
+/* Number of consecutive intervals with
+ * headroom before a feature is restored */
+#define A5200_GOVERNOR_RESTORE_INTERVALS 5
+#define A5200_GOVERNOR_FRAME_USEC (1000000 / A5200_FPS)
+
+static bool governor_enabled             = false;
+/* Thresholds, as a percentage of the
+ * frame time budget */
+static unsigned governor_threshold       = 90;
+static unsigned governor_headroom        = 50;
+/* Number of steps taken */
+static unsigned governor_level           = 0;
+static retro_time_t governor_time        = 0;
+static unsigned governor_frames          = 0;
+static unsigned governor_restore_count   = 0;
+/* Host time spent in the frontend audio
+ * callback, which may block on audio sync */
+static retro_time_t governor_output_time = 0;
+
+static bool governor_step_active(enum governor_step step)
+{
+   return governor_level > (unsigned)step;
+}
+
+/* The following apply the selected setting
+ * of each feature, unless the governor has
+ * stepped it down */
+static void apply_frame_blending(void)
+{
+   init_frame_blending(governor_step_active(GOVERNOR_STEP_BLENDING) ?
+         FRAME_BLEND_NONE : frame_blend_method);
+}
+
+static void apply_artifacting(void)
+{
+   bool step_down    = governor_step_active(GOVERNOR_STEP_ARTIFACTING);
+
+   global_artif_mode = step_down ? 0 : video_artif_mode;
+   video_composite   = !step_down && video_artif_composite;
+   ANTIC_UpdateArtifacting();
+}
+
+static void apply_pokey_engine(void)
+{
+   bool new_pokey = audio_new_pokey &&
+         !governor_step_active(GOVERNOR_STEP_POKEY);
+
+   if (new_pokey == (bool)POKEYSND_enable_new_pokey)
+      return;
+
+   /* The sound engine is reinitialised with
+    * the current POKEY register values */
+   POKEYSND_enable_new_pokey = new_pokey;
+   Atari800_RestartSound();
+#ifdef POKEYSND_THREAD
+   if (new_pokey && audio_thread_enabled)
+      POKEYSND_StartThread();
+#endif
+   audio_declick = true;
+}
+
+static void apply_governor_step(enum governor_step step)
+{
+#ifdef HAVE_PTHREAD
+   /* Worker must be idle while settings change */
+   video_thread_wait();
+#endif
+
+   switch (step)
+   {
+      case GOVERNOR_STEP_BLENDING:
+         apply_frame_blending();
+         break;
+      case GOVERNOR_STEP_ARTIFACTING:
+         apply_artifacting();
+         break;
+      case GOVERNOR_STEP_POKEY:
+         apply_pokey_engine();
+         break;
+      case GOVERNOR_STEP_FRAMESKIP:
+         frameskip_governor      = governor_step_active(step);
+         frameskip_governor_skip = false;
+         break;
+      default:
+         break;
+   }
+}
+
+/* Returns true if stepping down 'step'
+ * would have any effect */
+static bool governor_step_applicable(enum governor_step step)
+{
+   switch (step)
+   {
+      case GOVERNOR_STEP_BLENDING:
+         return frame_blend_method != FRAME_BLEND_NONE;
+      case GOVERNOR_STEP_ARTIFACTING:
+         return (video_artif_mode != 0) || video_artif_composite;
+      case GOVERNOR_STEP_POKEY:
+         return audio_new_pokey;
+      case GOVERNOR_STEP_FRAMESKIP:
+         return true;
+      default:
+         break;
+   }
+
+   return false;
+}
+
+static void governor_reset_stats(void)
+{
+   governor_time          = 0;
+   governor_frames        = 0;
+   governor_restore_count = 0;
+}
+
+/* Steps down the next applicable feature */
+static void governor_step_down(unsigned load)
+{
+   while (governor_level < GOVERNOR_STEP_COUNT)
+   {
+      enum governor_step step = (enum governor_step)governor_level++;
+
+      if (governor_step_applicable(step))
+      {
+         apply_governor_step(step);
+         a5200_log(RETRO_LOG_INFO,
+               "Quality governor: frame time %u%% of budget - stepping down %s.\n",
+               load, governor_step_names[step]);
+         return;
+      }
+   }
+}
+
+/* Restores the last feature stepped down */
+static void governor_step_up(unsigned load)
+{
+   while (governor_level > 0)
+   {
+      enum governor_step step = (enum governor_step)--governor_level;
+
+      if (governor_step_applicable(step))
+      {
+         apply_governor_step(step);
+         a5200_log(RETRO_LOG_INFO,
+               "Quality governor: frame time %u%% of budget - restoring %s.\n",
+               load, governor_step_names[step]);
+         return;
+      }
+   }
+}
+
+/* Restores all features */
+static void governor_reset(void)
+{
+   if (governor_level > 0)
+   {
+      a5200_log(RETRO_LOG_INFO,
+            "Quality governor: restoring all features.\n");
+
+      governor_level     = 0;
+      frameskip_governor = false;
+      apply_frame_blending();
+      apply_artifacting();
+      apply_pokey_engine();
+   }
+
+   governor_reset_stats();
 }
 
-static void blend_frames_ghost95(void)
+/* Adds the host time taken by a displayed
+ * frame, and steps features down or up once
+ * enough frames have been timed */
+static void governor_update(retro_time_t frame_time)
 {
-   /* 95% ~= 122 / 128 */
-   BLEND_FRAMES_GHOST(122);
-}
+   unsigned load;
 
-static void (*blend_frames)(void) = NULL;
+   governor_time += frame_time;
+   if (++governor_frames < A5200_GOVERNOR_INTERVAL)
+      return;
 
-static void init_frame_blending(enum frame_blend_method blend_method)
-{
-   /* Allocate/zero out buffer, if required */
-   if (blend_method != FRAME_BLEND_NONE)
-   {
-      if (!video_buffer_prev)
-         video_buffer_prev = (uint16_t*)malloc(A5200_VIDEO_WIDTH *
-               A5200_VIDEO_HEIGHT * sizeof(uint16_t));
+   load = (unsigned)((governor_time * 100) /
+         ((retro_time_t)governor_frames * A5200_GOVERNOR_FRAME_USEC));
+   governor_time   = 0;
+   governor_frames = 0;
 
-      memset(video_buffer_prev, 0, A5200_VIDEO_WIDTH *
-            A5200_VIDEO_HEIGHT * sizeof(uint16_t));
+   if (load > governor_threshold)
+   {
+      governor_restore_count = 0;
+      governor_step_down(load);
    }
-
-   /* Assign function pointer */
-   switch (blend_method)
+   else if ((load < governor_headroom) && (governor_level > 0))
    {
-      case FRAME_BLEND_MIX:
-         blend_frames = blend_frames_mix;
-         break;
-      case FRAME_BLEND_GHOST_65:
-         blend_frames = blend_frames_ghost65;
-         break;
-      case FRAME_BLEND_GHOST_75:
-         blend_frames = blend_frames_ghost75;
-         break;
-      case FRAME_BLEND_GHOST_85:
-         blend_frames = blend_frames_ghost85;
-         break;
-      case FRAME_BLEND_GHOST_95:
-         blend_frames = blend_frames_ghost95;
-         break;
-      default:
-         blend_frames = NULL;
-         break;
+      if (++governor_restore_count >= A5200_GOVERNOR_RESTORE_INTERVALS)
+      {
+         governor_restore_count = 0;
+         governor_step_up(load);
+      }
    }
+   else
+      governor_restore_count = 0;
 }
 
 /************************************
@@ -406,6 +1558,91 @@ void a5200_log(enum retro_log_level level, const char *format, ...)
             "[a5200] %s", msg);
 }
 
+#ifdef STAT_REGISTER_WRITES
+static const char *const antic_register_names[16] = {
+   "DMACTL", "CHACTL", "DLISTL", "DLISTH", "HSCROL", "VSCROL", "$06",   "PMBASE",
+   "$08",    "CHBASE", "WSYNC",  "$0B",    "$0C",    "$0D",    "NMIEN", "NMIRES"
+};
+
+static const char *const gtia_register_names[32] = {
+   "HPOSP0", "HPOSP1", "HPOSP2", "HPOSP3", "HPOSM0", "HPOSM1", "HPOSM2", "HPOSM3",
+   "SIZEP0", "SIZEP1", "SIZEP2", "SIZEP3", "SIZEM",  "GRAFP0", "GRAFP1", "GRAFP2",
+   "GRAFP3", "GRAFM",  "COLPM0", "COLPM1", "COLPM2", "COLPM3", "COLPF0", "COLPF1",
+   "COLPF2", "COLPF3", "COLBK",  "PRIOR",  "VDELAY", "GRACTL", "HITCLR", "CONSOL"
+};
+
+static const char *const pokey_register_names[16] = {
+   "AUDF1",  "AUDC1",  "AUDF2",  "AUDC2",  "AUDF3",  "AUDC3",  "AUDF4",  "AUDC4",
+   "AUDCTL", "STIMER", "SKRES",  "POTGO",  "$0C",    "SEROUT", "IRQEN",  "SKCTL"
+};
+
+static void log_register_write_stats(const char *chip,
+      const char *const *names, const unsigned int *writes,
+      const unsigned int *elided, size_t count)
+{
+   size_t i;
+
+   for (i = 0; i < count; i++)
+      if (writes[i] > 0)
+         a5200_log(RETRO_LOG_INFO,
+               "%-6s %-6s: %10u writes, %10u elided (%5.1f%%)\n",
+               chip, names[i], writes[i], elided[i],
+               (100.0 * (double)elided[i]) / (double)writes[i]);
+}
+
+/* Logs the number of writes to each hardware
+ * register since the content was loaded, and
+ * how many of them were redundant */
+static void log_register_stats(void)
+{
+   log_register_write_stats("ANTIC", antic_register_names,
+         antic_write_stat, antic_elided_write_stat, 16);
+   log_register_write_stats("GTIA", gtia_register_names,
+         gtia_write_stat, gtia_elided_write_stat, 32);
+   log_register_write_stats("POKEY", pokey_register_names,
+         pokey_write_stat, pokey_elided_write_stat, 16);
+   log_register_write_stats("POKEY2", pokey_register_names,
+         pokey_write_stat + 16, pokey_elided_write_stat + 16, 16);
+}
+
+static void reset_register_stats(void)
+{
+   memset(antic_write_stat, 0, sizeof(antic_write_stat));
+   memset(antic_elided_write_stat, 0, sizeof(antic_elided_write_stat));
+   memset(gtia_write_stat, 0, sizeof(gtia_write_stat));
+   memset(gtia_elided_write_stat, 0, sizeof(gtia_elided_write_stat));
+   memset(pokey_write_stat, 0, sizeof(pokey_write_stat));
+   memset(pokey_elided_write_stat, 0, sizeof(pokey_elided_write_stat));
+}
+#endif
+
+#ifdef STAT_RESAMPLING
+/* Logs the accuracy of the single precision
+ * resampler of the 'High Fidelity' POKEY
+ * engine, relative to the double precision
+ * reference, since the content was loaded */
+static void log_resampling_stats(void)
+{
+   if (MZPOKEYSND_resam_error_energy > 0.0)
+      a5200_log(RETRO_LOG_INFO,
+            "Resampling SNR: %.1f dB, max error: %g (%.4f LSB)\n",
+            10.0 * log10(MZPOKEYSND_resam_signal_energy /
+                  MZPOKEYSND_resam_error_energy),
+            MZPOKEYSND_resam_max_error,
+            MZPOKEYSND_resam_max_error *
+                  (65535.0 / 2 / 152 / 4 * PI * 0.95));
+   else
+      a5200_log(RETRO_LOG_INFO, "Resampling error: none\n");
+}
+
+static void reset_resampling_stats(void)
+{
+   MZPOKEYSND_resam_signal_energy = 0.0;
+   MZPOKEYSND_resam_error_energy  = 0.0;
+   MZPOKEYSND_resam_max_error     = 0.0;
+}
+#endif
+
 static void load_bios(void)
 {
    const char *system_dir = NULL;
@@ -512,6 +1749,8 @@ static void initialise_palette(void)
 
       a5200_palette_rgb565[i] = (r >> 3) << 11 | (g >> 3) << 6 | (b >> 3);
    }
+
+   a5200_ntsc_init(a5200_palette_ntsc);
 }
 
 static void init_input_descriptors(void)
@@ -634,11 +1873,21 @@ static void check_pokey_variable(void)
     var.key = "a5200_enable_new_pokey";
     var.value = NULL;
     POKEYSND_enable_new_pokey = true;
+    POKEYSND_band_limited     = false;
 
     if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
-        !string_is_empty(var.value) &&
-        string_is_equal(var.value, "disabled"))
-        POKEYSND_enable_new_pokey = false;
+        !string_is_empty(var.value))
+    {
+        if (string_is_equal(var.value, "disabled"))
+            POKEYSND_enable_new_pokey = false;
+        else if (string_is_equal(var.value, "band_limited"))
+        {
+            POKEYSND_enable_new_pokey = false;
+            POKEYSND_band_limited     = true;
+        }
+    }
+
+    audio_new_pokey = POKEYSND_enable_new_pokey;
 
     a5200_log(RETRO_LOG_INFO, "High Fidelity Pokey: %s\n", var.value);
 }
@@ -646,58 +1895,301 @@ static void check_pokey_variable(void)
 static void check_variables(void)
 {
    struct retro_variable var = {0};
-   enum frame_blend_method blend_method;
+   enum frameskip_type prev_frameskip_type;
+   bool prev_perf_hud;
+   unsigned prev_video_width     = video_width;
+   unsigned prev_video_height    = video_height;
+   unsigned prev_video_out_width = video_out_width;
+   unsigned prev_video_scale     = a5200_scale_factor(video_scaler);
+
+#ifdef HAVE_PTHREAD
+   /* Threaded Video */
+   var.key              = "a5200_video_thread";
+   var.value            = NULL;
+   video_thread_enabled = false;
 
-   /* Interframe Blending */
-   var.key      = "a5200_mix_frames";
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      if (string_is_equal(var.value, "enabled"))
+         video_thread_enabled = true;
+
+   if (video_thread_enabled)
+      init_video_thread();
+   else
+      deinit_video_thread();
+#endif
+
+   /* Scanline Cycle Overlay */
+   var.key             = "a5200_cycle_overlay";
+   var.value           = NULL;
+   video_cycle_overlay = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      if (string_is_equal(var.value, "enabled"))
+         video_cycle_overlay = true;
+
+   /* Performance HUD */
+   var.key        = "a5200_perf_hud";
+   var.value      = NULL;
+   prev_perf_hud  = video_perf_hud;
+   video_perf_hud = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      if (string_is_equal(var.value, "enabled"))
+         video_perf_hud = true;
+
+   if (video_perf_hud && !prev_perf_hud)
+      reset_perf_hud();
+
+   antic_collect_line_stats = video_cycle_overlay || video_perf_hud;
+
+   /* Performance Trace */
+   var.key   = "a5200_trace";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value &&
+       string_is_equal(var.value, "enabled"))
+      init_trace();
+   else
+      deinit_trace();
+
+   /* POKEY Register Trace */
+   var.key   = "a5200_pokey_trace";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value &&
+       string_is_equal(var.value, "enabled"))
+      init_pokey_trace();
+   else
+      deinit_pokey_trace();
+
+   /* Horizontal Crop */
+   var.key     = "a5200_crop_horizontal";
+   var.value   = NULL;
+   video_width = A5200_VIDEO_WIDTH;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+   {
+      /* Must be a multiple of 16, so the
+       * render window is 8 pixel aligned */
+      video_width = string_to_unsigned(var.value) & ~15;
+      if ((video_width < 256) || (video_width > A5200_VIDEO_WIDTH))
+         video_width = A5200_VIDEO_WIDTH;
+   }
+
+   /* Vertical Crop */
+   var.key      = "a5200_crop_vertical";
+   var.value    = NULL;
+   video_height = A5200_VIDEO_HEIGHT;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+   {
+      video_height = string_to_unsigned(var.value) & ~1;
+      if ((video_height < 192) || (video_height > A5200_VIDEO_HEIGHT))
+         video_height = A5200_VIDEO_HEIGHT;
+   }
+
+   if ((video_width != prev_video_width) ||
+       (video_height != prev_video_height))
+      init_render_window();
+
+   /* Horizontal Resolution */
+   var.key          = "a5200_horizontal_res";
+   var.value        = NULL;
+   video_half_width = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      if (string_is_equal(var.value, "half"))
+         video_half_width = true;
+
+   video_out_width = video_half_width ? (video_width >> 1) : video_width;
+
+   /* Integer Scaling */
+   var.key      = "a5200_scaler";
    var.value    = NULL;
-   blend_method = FRAME_BLEND_NONE;
+   video_scaler = A5200_SCALER_NONE;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+   {
+      if (string_is_equal(var.value, "2x"))
+         video_scaler = A5200_SCALER_2X;
+      else if (string_is_equal(var.value, "3x"))
+         video_scaler = A5200_SCALER_3X;
+      else if (string_is_equal(var.value, "2x_scanlines"))
+         video_scaler = A5200_SCALER_2X_SCANLINES;
+      else if (string_is_equal(var.value, "3x_scanlines"))
+         video_scaler = A5200_SCALER_3X_SCANLINES;
+      else if (string_is_equal(var.value, "scale2x"))
+         video_scaler = A5200_SCALER_SCALE2X;
+   }
+
+   if ((video_scaler != A5200_SCALER_NONE) && !init_video_scaler())
+   {
+      a5200_log(RETRO_LOG_WARN,
+            "Integer scaling disabled - failed to allocate buffers.\n");
+      video_scaler = A5200_SCALER_NONE;
+   }
+
+   if ((video_out_width != prev_video_out_width) ||
+       (video_height != prev_video_height) ||
+       (a5200_scale_factor(video_scaler) != prev_video_scale))
+      update_geometry = true;
+
+   /* Interframe Blending */
+   var.key            = "a5200_mix_frames";
+   var.value          = NULL;
+   frame_blend_method = FRAME_BLEND_NONE;
 
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
        !string_is_empty(var.value))
    {
       if (string_is_equal(var.value, "mix"))
-         blend_method = FRAME_BLEND_MIX;
+         frame_blend_method = FRAME_BLEND_MIX;
       else if (string_is_equal(var.value, "ghost_65"))
-         blend_method = FRAME_BLEND_GHOST_65;
+         frame_blend_method = FRAME_BLEND_GHOST_65;
       else if (string_is_equal(var.value, "ghost_75"))
-         blend_method = FRAME_BLEND_GHOST_75;
+         frame_blend_method = FRAME_BLEND_GHOST_75;
       else if (string_is_equal(var.value, "ghost_85"))
-         blend_method = FRAME_BLEND_GHOST_85;
+         frame_blend_method = FRAME_BLEND_GHOST_85;
       else if (string_is_equal(var.value, "ghost_95"))
-         blend_method = FRAME_BLEND_GHOST_95;
+         frame_blend_method = FRAME_BLEND_GHOST_95;
    }
 
-   init_frame_blending(blend_method);
+   apply_frame_blending();
 
    /* Set artifacting type.  */
    var.key = "a5200_artifacting_mode";
    var.value = NULL;
+   video_artif_composite = false;
 
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
    {
        if (strcmp(var.value, "none") == 0)
        {
-           global_artif_mode = 0;
+           video_artif_mode = 0;
        }
        if (strcmp(var.value, "blue/brown 1") == 0)
        {
-           global_artif_mode = 1;
+           video_artif_mode = 1;
        }
        else if (strcmp(var.value, "blue/brown 2") == 0)
        {
-           global_artif_mode = 2;
+           video_artif_mode = 2;
        }
        else if (strcmp(var.value, "GTIA") == 0)
        {
-           global_artif_mode = 3;
+           video_artif_mode = 3;
        }
        else if (strcmp(var.value, "CTIA") == 0)
        {
-           global_artif_mode = 4;
+           video_artif_mode = 4;
        }
+       else if (strcmp(var.value, "composite") == 0)
+       {
+           /* Artifacts are produced by the composite
+            * filter, for all modes */
+           video_artif_mode = 0;
+           video_artif_composite = true;
+       }
+   }
+
+   apply_artifacting();
 
-       ANTIC_UpdateArtifacting();
+   /* Frameskip */
+   var.key             = "a5200_frameskip";
+   var.value           = NULL;
+   prev_frameskip_type = frameskip_type;
+   frameskip_type      = FRAMESKIP_NONE;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+   {
+      if (string_is_equal(var.value, "auto"))
+         frameskip_type = FRAMESKIP_AUTO;
+      else if (string_is_equal(var.value, "manual"))
+         frameskip_type = FRAMESKIP_MANUAL;
+      else if (string_is_equal(var.value, "fixed"))
+         frameskip_type = FRAMESKIP_FIXED;
+   }
+
+   /* Frameskip Threshold */
+   var.key             = "a5200_frameskip_threshold";
+   var.value           = NULL;
+   frameskip_threshold = 33;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+      frameskip_threshold = string_to_unsigned(var.value);
+
+   /* Fixed Frameskip Interval */
+   var.key            = "a5200_frameskip_interval";
+   var.value          = NULL;
+   frameskip_interval = 1;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+      frameskip_interval = string_to_unsigned(var.value);
+
+   if (frameskip_interval < 1)
+      frameskip_interval = 1;
+
+   /* (Re)register the audio buffer status
+    * callback when the frameskip type changes */
+   if ((frameskip_type != prev_frameskip_type) ||
+       (video_perf_hud != prev_perf_hud))
+      init_frameskip();
+
+   /* Quality Governor */
+   var.key          = "a5200_governor";
+   var.value        = NULL;
+   governor_enabled = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value &&
+       string_is_equal(var.value, "enabled"))
+   {
+      if (perf_cb.get_time_usec)
+         governor_enabled = true;
+      else
+         a5200_log(RETRO_LOG_WARN,
+               "Quality governor disabled - frontend does not provide a timer.\n");
+   }
+
+   if (!governor_enabled)
+      governor_reset();
+
+   /* Quality Governor Threshold */
+   var.key            = "a5200_governor_threshold";
+   var.value          = NULL;
+   governor_threshold = 90;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+      governor_threshold = string_to_unsigned(var.value);
+
+   /* Quality Governor Headroom */
+   var.key           = "a5200_governor_headroom";
+   var.value         = NULL;
+   governor_headroom = 50;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+      governor_headroom = string_to_unsigned(var.value);
+
+   /* Audio Sample Rate */
+   var.key           = "a5200_sample_rate";
+   var.value         = NULL;
+   audio_sample_rate = SOUND_SAMPLE_RATE;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+       !string_is_empty(var.value))
+   {
+      unsigned sample_rate = string_to_unsigned(var.value);
+
+      if ((sample_rate >= A5200_SAMPLE_RATE_MIN) &&
+          (sample_rate <= A5200_SAMPLE_RATE_MAX))
+         audio_sample_rate = sample_rate;
    }
 
    /* Audio Filter */
@@ -722,6 +2214,30 @@ static void check_variables(void)
       audio_low_pass_range  = (filter_level * 0x10000) / 100;
    }
 
+   POKEYSND_lowpass_factor = audio_low_pass_enabled ?
+         audio_low_pass_range : 0;
+
+#ifdef POKEYSND_THREAD
+   /* Threaded Audio */
+   var.key   = "a5200_audio_thread";
+   var.value = NULL;
+
+   audio_thread_enabled = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value &&
+       string_is_equal(var.value, "enabled"))
+   {
+      audio_thread_enabled = true;
+
+      /* Only possible with High Fidelity POKEY */
+      if (!POKEYSND_StartThread() && POKEYSND_enable_new_pokey)
+         a5200_log(RETRO_LOG_WARN,
+               "Threaded audio disabled - failed to create worker thread.\n");
+   }
+   else
+      POKEYSND_StopThread();
+#endif
+
    /* Controller Hacks */
    var.key    = "a5200_input_hack";
    var.value  = NULL;
@@ -1219,79 +2735,105 @@ static void update_input_osk(void)
 
 static void update_video(void)
 {
-   uint16_t *video_buffer_ptr = video_buffer;
-   size_t x, y;
-
-   for (y = 0; y < A5200_VIDEO_HEIGHT; y++)
-   {
-      uint8_t *screen_buffer_ptr = a5200_screen_buffer +
-            ((y + A5200_VIDEO_OFFSET_Y) * A5200_SCREEN_BUFFER_WIDTH) +
-            A5200_VIDEO_OFFSET_X;
+   render_video(a5200_screen_buffer, video_buffer);
 
-      for (x = 0; x < A5200_VIDEO_WIDTH; x++)
-         *(video_buffer_ptr++) = a5200_palette_rgb565[*(screen_buffer_ptr + x)];
-   }
+   if (video_cycle_overlay)
+      draw_cycle_overlay(video_buffer, video_out_width, video_height,
+            ANTIC_line_stats);
 
-   if (blend_frames)
-      blend_frames();
+   draw_perf_hud(video_buffer, video_out_width, video_height);
 
    if (input_show_osk)
-      a5200_osk_draw(video_buffer, A5200_VIDEO_WIDTH,
-            A5200_VIDEO_HEIGHT);
+      a5200_osk_draw(video_buffer, video_out_width, video_height,
+            video_half_width);
 
-   video_cb(video_buffer, A5200_VIDEO_WIDTH, A5200_VIDEO_HEIGHT,
-         A5200_VIDEO_WIDTH << 1);
+   output_video(video_buffer, video_out_width, video_height,
+         video_scaler, false);
 }
 
-static void update_audio(void)
+/* Fades out the step in the mean output level
+ * caused by a switch of the sound engine */
+static void declick_audio(int16_t *buffer, unsigned samples)
 {
-   uint8_t *samples_ptr = audio_samples_buffer;
-   int16_t *out_ptr   = audio_out_buffer;
-   size_t i;
-
-   Pokey_process(samples_ptr, A5200_AUDIO_BUFFER_SIZE);
+   int32_t level[2] = {0};
+   unsigned i;
+   int c;
 
-   if (audio_low_pass_enabled)
+   for (i = 0; i < (samples << 1); i += 2)
    {
-      /* Restore previous sample */
-      int32_t low_pass = audio_low_pass_prev;
-      /* Single-pole low-pass filter (6 dB/octave) */
-      int32_t factor_a = audio_low_pass_range;
-      int32_t factor_b = 0x10000 - factor_a;
-
-      for(i = 0; i < A5200_AUDIO_BUFFER_SIZE; i++)
-      {
-         /* Convert 8u mono to 16s stereo */
-         int16_t sample_16 = (int16_t)((*(samples_ptr++) - 128) << 8);
-
-         /* Apply low-pass filter */
-         low_pass = (low_pass * factor_a) + (sample_16 * factor_b);
+      level[0] += buffer[i];
+      level[1] += buffer[i + 1];
+   }
+   level[0] /= (int32_t)samples;
+   level[1] /= (int32_t)samples;
 
-         /* 16.16 fixed point */
-         low_pass >>= 16;
+   if (audio_declick)
+   {
+      audio_declick_step[0] = audio_frame_level[0] - level[0];
+      audio_declick_step[1] = audio_frame_level[1] - level[1];
+      audio_declick_pos     = 0;
+      audio_declick_length  = samples * A5200_DECLICK_FRAMES;
+      audio_declick         = false;
+   }
 
-         /* Update output buffer */
-         *(out_ptr++) = (int16_t)low_pass;
-         *(out_ptr++) = (int16_t)low_pass;
-      }
+   audio_frame_level[0] = level[0];
+   audio_frame_level[1] = level[1];
 
-      /* Save last sample for next frame */
-      audio_low_pass_prev = low_pass;
-   }
-   else
+   for (i = 0; (i < samples) &&
+         (audio_declick_pos < audio_declick_length); i++)
    {
-      for(i = 0; i < A5200_AUDIO_BUFFER_SIZE; i++)
+      int32_t remaining = (int32_t)(audio_declick_length -
+            audio_declick_pos++);
+
+      for (c = 0; c < 2; c++)
       {
-         /* Convert 8u mono to 16s stereo */
-         int16_t sample_16 = (int16_t)((*(samples_ptr++) - 128) << 8);
+         int32_t sample = buffer[c] + (audio_declick_step[c] *
+               remaining) / (int32_t)audio_declick_length;
 
-         /* Update output buffer */
-         *(out_ptr++) = sample_16;
-         *(out_ptr++) = sample_16;
+         buffer[c] = (int16_t)(sample > 32767 ? 32767 :
+               (sample < -32768 ? -32768 : sample));
       }
+      buffer += 2;
    }
+}
+
+static void update_audio(void)
+{
+   int16_t *buffer;
+   unsigned samples;
+   retro_time_t output_start_time = 0;
+
+   a5200_pokey_trace_frame(cpu_clock);
+
+#ifdef SYNCHRONIZED_SOUND
+   /* Samples are generated as the frame is emulated
+    * (16 bit stereo, low-pass filtered) - output the
+    * remainder of the frame and send the lot */
+   samples = (unsigned)POKEYSND_UpdateProcessBuffer();
+   buffer  = (int16_t*)POKEYSND_process_buffer;
+#else
+   unsigned samples_x_fps = (unsigned)sound_sample_rate +
+         audio_samples_remainder;
+
+   samples                 = samples_x_fps / A5200_FPS;
+   buffer                  = audio_out_buffer;
+   audio_samples_remainder = samples_x_fps % A5200_FPS;
+
+   /* POKEY output is 16 bit stereo, with the
+    * low-pass filter applied as it is generated */
+   Pokey_process(audio_out_buffer, samples);
+#endif
 
-   audio_batch_cb(audio_out_buffer, A5200_AUDIO_BUFFER_SIZE);
+   if (samples > 0)
+      declick_audio(buffer, samples);
+
+   if (governor_enabled)
+      output_start_time = hud_get_time();
+
+   audio_batch_cb(buffer, samples);
+
+   if (governor_enabled)
+      governor_output_time = hud_get_time() - output_start_time;
 }
 
 /************************************
@@ -1367,12 +2909,19 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
 {
    memset(info, 0, sizeof(*info));
    info->timing.fps            = (double)A5200_FPS;
-   info->timing.sample_rate    = (double)SOUND_SAMPLE_RATE;
-   info->geometry.base_width   = A5200_VIDEO_WIDTH;
-   info->geometry.base_height  = A5200_VIDEO_HEIGHT;
-   info->geometry.max_width    = A5200_VIDEO_WIDTH;
-   info->geometry.max_height   = A5200_VIDEO_HEIGHT;
-   info->geometry.aspect_ratio = 4.0f / 3.0f;
+   info->timing.sample_rate    = (double)sound_sample_rate;
+   info->geometry.base_width   = video_out_width *
+         a5200_scale_factor(video_scaler);
+   info->geometry.base_height  = video_height *
+         a5200_scale_factor(video_scaler);
+   info->geometry.max_width    = A5200_VIDEO_WIDTH * A5200_SCALE_MAX;
+   info->geometry.max_height   = A5200_VIDEO_HEIGHT * A5200_SCALE_MAX;
+   /* 4:3 at the default 320x224 crop - the display
+    * aspect ratio is independent of the horizontal
+    * resolution and scale factor */
+   info->geometry.aspect_ratio = (4.0f / 3.0f) *
+         ((float)video_width / (float)A5200_VIDEO_WIDTH) *
+         ((float)A5200_VIDEO_HEIGHT / (float)video_height);
 }
 
 void retro_set_controller_port_device(unsigned port, unsigned device)
@@ -1405,7 +2954,13 @@ size_t retro_serialize_size(void)
 
 bool retro_serialize(void *data, size_t size)
 {
-   return SaveAtariState(data, size, 0);
+   bool success;
+
+   a5200_trace_begin("retro_serialize");
+   success = SaveAtariState(data, size, 0) ? true : false;
+   a5200_trace_end();
+
+   return success;
 }
 
 bool retro_unserialize(const void *data, size_t size)
@@ -1468,6 +3023,10 @@ bool retro_load_game(const struct retro_game_info *info)
       goto error;
    }
 
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_CAN_DUPE, &video_can_dupe))
+      video_can_dupe = false;
+   video_last_buffer = NULL;
+
    /* Load bios */
    check_bios_variable();
    check_pokey_variable();
@@ -1481,6 +3040,18 @@ bool retro_load_game(const struct retro_game_info *info)
       goto error;
    }
 
+#ifdef STAT_REGISTER_WRITES
+   reset_register_stats();
+#endif
+#ifdef STAT_RESAMPLING
+   reset_resampling_stats();
+#endif
+   sound_sample_rate       = (int)audio_sample_rate;
+#ifdef SYNCHRONIZED_SOUND
+   POKEYSND_frame_rate     = (double)A5200_FPS;
+#else
+   audio_samples_remainder = 0;
+#endif
    Atari800_Initialise();
 
    /* Apply initial core options */
@@ -1505,6 +3076,25 @@ bool retro_load_game_special(unsigned game_type, const struct retro_game_info *i
 
 void retro_unload_game(void) 
 {
+#ifdef HAVE_PTHREAD
+   deinit_video_thread();
+#endif
+#ifdef POKEYSND_THREAD
+   POKEYSND_StopThread();
+#endif
+#ifdef STAT_REGISTER_WRITES
+   log_register_stats();
+#endif
+#ifdef STAT_RESAMPLING
+   log_resampling_stats();
+#endif
+   write_trace();
+   deinit_pokey_trace();
+   /* Stepped down features are restored when
+    * the next content is loaded */
+   governor_level     = 0;
+   frameskip_governor = false;
+   governor_reset_stats();
    CART_Remove();
    Atari800_Exit();
 
@@ -1548,8 +3138,14 @@ void retro_init(void)
    if (environ_cb(RETRO_ENVIRONMENT_GET_INPUT_BITMASKS, NULL))
       libretro_supports_bitmasks = true;
 
-   a5200_screen_buffer = (uint8_t*)malloc(A5200_SCREEN_BUFFER_WIDTH *
-         A5200_SCREEN_BUFFER_HEIGHT * sizeof(uint8_t));
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_PERF_INTERFACE, &perf_cb))
+      memset(&perf_cb, 0, sizeof(perf_cb));
+
+   video_width      = A5200_VIDEO_WIDTH;
+   video_height     = A5200_VIDEO_HEIGHT;
+   video_half_width = false;
+   video_out_width  = A5200_VIDEO_WIDTH;
+   init_render_window();
 #ifdef _3DS
    video_buffer = (uint16_t*)linearMemAlign(A5200_VIDEO_WIDTH *
          A5200_VIDEO_HEIGHT * sizeof(uint16_t), 128);
@@ -1558,17 +3154,14 @@ void retro_init(void)
          A5200_VIDEO_HEIGHT * sizeof(uint16_t));
 #endif
 
-   memset(a5200_screen_buffer, 0, A5200_SCREEN_BUFFER_WIDTH *
-         A5200_SCREEN_BUFFER_HEIGHT * sizeof(uint8_t));
    memset(video_buffer, 0, A5200_VIDEO_WIDTH *
          A5200_VIDEO_HEIGHT * sizeof(uint16_t));
 
-   /* Mono */
-   audio_samples_buffer = (uint8_t*)malloc(A5200_AUDIO_BUFFER_SIZE *
-         sizeof(uint8_t));
+#ifndef SYNCHRONIZED_SOUND
    /* Stereo */
    audio_out_buffer     = (int16_t*)malloc((A5200_AUDIO_BUFFER_SIZE << 1) *
          sizeof(int16_t));
+#endif
 
    input_shift_ctrl        = 0;
    input_hack              = INPUT_HACK_NONE;
@@ -1576,9 +3169,17 @@ void retro_init(void)
    input_show_osk          = false;
    input_osk_toggle_lock   = false;
    input_osk_cursor_latch  = 0;
-   audio_low_pass_prev     = 0;
+   POKEYSND_lowpass_prev   = 0;
    a5200_use_official_bios = true;
 
+   frameskip_type             = FRAMESKIP_NONE;
+   frameskip_counter          = 0;
+   retro_audio_buff_active    = false;
+   retro_audio_buff_occupancy = 0;
+   retro_audio_buff_underrun  = false;
+   audio_latency              = 0;
+   update_audio_latency       = false;
+
    initialise_palette();
    a5200_osk_init();
 }
@@ -1586,20 +3187,59 @@ void retro_init(void)
 void retro_deinit(void)
 {
    libretro_supports_bitmasks = false;
+   video_can_dupe             = false;
+   video_last_buffer          = NULL;
    input_shift_ctrl           = 0;
    input_hack                 = INPUT_HACK_NONE;
    input_analog_quadratic     = false;
    input_show_osk             = false;
    input_osk_toggle_lock      = false;
    input_osk_cursor_latch     = 0;
-   audio_low_pass_prev        = 0;
+   POKEYSND_lowpass_prev      = 0;
    a5200_use_official_bios    = true;
+   frameskip_type             = FRAMESKIP_NONE;
+   frameskip_counter          = 0;
+   retro_audio_buff_active    = false;
+   retro_audio_buff_occupancy = 0;
+   retro_audio_buff_underrun  = false;
+   audio_latency              = 0;
+   update_audio_latency       = false;
+   antic_skip_render          = 0;
+   antic_collect_line_stats   = 0;
+   video_cycle_overlay        = false;
+   video_perf_hud             = false;
+   governor_enabled           = false;
+   governor_level             = 0;
+   frameskip_governor         = false;
+   audio_declick              = false;
+   audio_declick_length       = 0;
+   a5200_trace_deinit();
+   antic_trace_hook           = NULL;
+   deinit_pokey_trace();
+
+#ifdef HAVE_PTHREAD
+   deinit_video_thread();
+   video_thread_enabled = false;
+
+   if (video_buffer_alt)
+   {
+#ifdef _3DS
+      linearFree(video_buffer_alt);
+#else
+      free(video_buffer_alt);
+#endif
+      video_buffer_alt = NULL;
+   }
+#endif
 
-   if (a5200_screen_buffer)
+   if (screen_buffer_raw)
    {
-      free(a5200_screen_buffer);
-      a5200_screen_buffer = NULL;
+      free(screen_buffer_raw);
+      screen_buffer_raw = NULL;
    }
+   memset(screen_buffers, 0, sizeof(screen_buffers));
+   a5200_screen_buffer = NULL;
+   update_geometry     = false;
 
    if (video_buffer)
    {
@@ -1617,17 +3257,16 @@ void retro_deinit(void)
       video_buffer_prev = NULL;
    }
 
-   if (audio_samples_buffer)
-   {
-      free(audio_samples_buffer);
-      audio_samples_buffer = NULL;
-   }
+   deinit_video_scaler();
+   video_scaler = A5200_SCALER_NONE;
 
+#ifndef SYNCHRONIZED_SOUND
    if (audio_out_buffer)
    {
       free(audio_out_buffer);
       audio_out_buffer = NULL;
    }
+#endif
 
    a5200_osk_deinit();
 }
@@ -1640,26 +3279,128 @@ void retro_reset(void)
 
 void retro_run(void)
 {
-   bool options_updated = false;
+   bool options_updated            = false;
+   bool skip_frame                 = false;
+   retro_time_t run_start_time     = 0;
+   retro_time_t frame_start_time   = 0;
+   retro_time_t emulation_end_time = 0;
+   retro_time_t video_end_time     = 0;
+
+   a5200_trace_begin("retro_run");
+
+   if (governor_enabled)
+      run_start_time = hud_get_time();
 
    /* Core options */
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE, &options_updated) &&
        options_updated)
+   {
+      a5200_trace_begin("check_variables");
+#ifdef HAVE_PTHREAD
+      /* Worker must be idle while settings change */
+      video_thread_wait();
+#endif
       check_variables();
+      a5200_trace_end();
+   }
+
+   /* Apply sample rate changes - this reinitialises
+    * the frontend audio driver, so the geometry is
+    * updated at the same time */
+   if (audio_sample_rate != (unsigned)sound_sample_rate)
+   {
+      struct retro_system_av_info av_info;
+
+      Atari800_SetSampleRate((int)audio_sample_rate);
+#ifndef SYNCHRONIZED_SOUND
+      audio_samples_remainder = 0;
+#endif
+
+      retro_get_system_av_info(&av_info);
+      environ_cb(RETRO_ENVIRONMENT_SET_SYSTEM_AV_INFO, &av_info);
+      update_geometry = false;
+   }
+
+   /* Apply crop changes to frontend geometry */
+   if (update_geometry)
+   {
+      struct retro_system_av_info av_info;
+      retro_get_system_av_info(&av_info);
+      environ_cb(RETRO_ENVIRONMENT_SET_GEOMETRY, &av_info.geometry);
+      update_geometry = false;
+   }
+
+   /* Frontend audio latency must be updated
+    * from within retro_run() */
+   if (update_audio_latency)
+   {
+      environ_cb(RETRO_ENVIRONMENT_SET_MINIMUM_AUDIO_LATENCY,
+            &audio_latency);
+      update_audio_latency = false;
+   }
 
    /* Update input */
+   a5200_trace_begin("input");
    input_poll_cb();
    if (input_show_osk)
       update_input_osk();
    else
       update_input();
+   a5200_trace_end();
+
+   /* Check whether current frame should
+    * be skipped */
+   skip_frame        = frameskip_check();
+   antic_skip_render = skip_frame;
 
    /* Run emulator */
+   if (video_perf_hud)
+      frame_start_time = hud_get_time();
+
+   a5200_trace_begin("Atari800_Frame");
    Atari800_Frame();
+   a5200_trace_end();
+
+   if (video_perf_hud)
+      emulation_end_time = hud_get_time();
 
    /* Output video */
-   update_video();
+   a5200_trace_begin("update_video");
+#ifdef HAVE_PTHREAD
+   if (video_thread_running)
+   {
+      video_thread_present();
+      if (!skip_frame)
+         video_thread_submit();
+   }
+   else
+#endif
+   if (skip_frame)
+      output_video_dupe();
+   else
+      update_video();
+   a5200_trace_end();
+
+   if (video_perf_hud)
+      video_end_time = hud_get_time();
 
    /* Output audio */
+   a5200_trace_begin("update_audio");
    update_audio();
+   a5200_trace_end();
+
+   if (video_perf_hud)
+      update_perf_hud(emulation_end_time - frame_start_time,
+            video_end_time - emulation_end_time,
+            hud_get_time() - video_end_time, skip_frame);
+
+   /* Only displayed frames are timed, and the
+    * frontend audio callback is excluded. Frames
+    * on which the core options changed include
+    * one-off reinitialisation costs */
+   if (governor_enabled && !skip_frame && !options_updated)
+      governor_update(hud_get_time() - run_start_time -
+            governor_output_time);
+
+   a5200_trace_end();
 }
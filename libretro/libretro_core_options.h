@@ -104,7 +104,7 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       "a5200_artifacting_mode",
       "Hi-Res Artifacting Mode",
       NULL,
-      "Set Hi-Res Artifacting mode used.  Typically dependant on the actual emulated system.  Pick the color combination that pleases you.  None disables artifacting.  Good for games like A.E., Backgammon, Miniature Golf and several Atari 800 to Atari 5200 conversions ",
+      "Set Hi-Res Artifacting mode used.  Typically dependant on the actual emulated system.  Pick the color combination that pleases you.  None disables artifacting.  Good for games like A.E., Backgammon, Miniature Golf and several Atari 800 to Atari 5200 conversions. NTSC Composite simulates the composite video signal in software, with colour bleeding in all modes; it is slower than the other settings.",
       NULL,
       NULL,
       {
@@ -113,15 +113,298 @@ struct retro_core_option_v2_definition option_defs_us[] = {
          { "blue/brown 2",  NULL },
          { "GTIA",  NULL },
          { "CTIA",  NULL },
+         { "composite", "NTSC Composite" },
          { NULL, NULL },
       },
       "none"
    },
+   {
+      "a5200_crop_horizontal",
+      "Horizontal Crop",
+      NULL,
+      "Set the width of the visible display area, centred on the screen. Only the visible area is rendered, so cropping further also reduces the emulation cost.",
+      NULL,
+      NULL,
+      {
+         { "320", "320 pixels" },
+         { "304", "304 pixels" },
+         { "288", "288 pixels" },
+         { "272", "272 pixels" },
+         { "256", "256 pixels" },
+         { NULL, NULL },
+      },
+      "320"
+   },
+   {
+      "a5200_crop_vertical",
+      "Vertical Crop",
+      NULL,
+      "Set the height of the visible display area, centred on the screen. Only the visible area is rendered, so cropping further also reduces the emulation cost.",
+      NULL,
+      NULL,
+      {
+         { "224", "224 lines" },
+         { "216", "216 lines" },
+         { "208", "208 lines" },
+         { "200", "200 lines" },
+         { "192", "192 lines" },
+         { NULL, NULL },
+      },
+      "224"
+   },
+   {
+      "a5200_horizontal_res",
+      "Horizontal Resolution",
+      NULL,
+      "Set the horizontal resolution of the video output. 'Half' outputs one pixel per colour clock (160 pixels at the default crop), which is the native resolution of almost all games and roughly halves the cost of video conversion and interframe blending. Pixels of the hi-res modes (2, 3, F) are averaged in pairs.",
+      NULL,
+      NULL,
+      {
+         { "full", "Full" },
+         { "half", "Half" },
+         { NULL, NULL },
+      },
+      "full"
+   },
+   {
+      "a5200_scaler",
+      "Integer Scaling",
+      NULL,
+      "Scale the video output by an integer factor within the core. Intended for frontends without shader support, where it is faster than generic software scaling. 'Scanlines' darkens the last line of each scaled line. 'Scale2x' smooths diagonal edges.",
+      NULL,
+      NULL,
+      {
+         { "disabled",     NULL },
+         { "2x",           "2x" },
+         { "3x",           "3x" },
+         { "2x_scanlines", "2x Scanlines" },
+         { "3x_scanlines", "3x Scanlines" },
+         { "scale2x",      "Scale2x" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#ifdef HAVE_PTHREAD
+   {
+      "a5200_video_thread",
+      "Threaded Video",
+      NULL,
+      "Perform palette conversion and interframe blending on a separate thread, in parallel with emulation of the next frame. Reduces frame times on multi-core devices, at the expense of one frame of additional input latency.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#endif
+   {
+      "a5200_cycle_overlay",
+      "Scanline Cycle Overlay",
+      NULL,
+      "Show how the CPU cycles of each scanline are spent, as a bar at the right edge of the screen: red for cycles stolen by ANTIC DMA, green for cycles executed by the CPU, blue for cycles the CPU is halted by WSYNC. Display list (yellow) and vertical blank (white) interrupts are marked to the left of the bar. Intended for debugging and performance analysis.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "a5200_perf_hud",
+      "Performance Overlay",
+      NULL,
+      "Show a summary of performance in the top left corner of the screen, updated every 30 frames: host time per frame spent on emulation, video and audio (ms), the share of emulated cycles executed by the CPU, stolen by ANTIC DMA and halted by WSYNC, frames skipped, and frontend audio buffer occupancy.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "a5200_trace",
+      "Performance Trace",
+      NULL,
+      "Record the time spent in each phase of every frame (input, emulation in bands of scanlines, video, audio, save states). The most recent minute is written to 'a5200_trace.json' in the save directory when content is closed or the option is disabled, for viewing in chrome://tracing or Perfetto.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "a5200_pokey_trace",
+      "POKEY Register Trace",
+      NULL,
+      "Record every write to the POKEY sound registers, with the CPU cycle at which it occurs, to 'a5200_pokey.trace' in the save directory. Recording starts when content is loaded or the option is enabled, overwriting any previous trace. Traces may be replayed by tools/pokey_bench to benchmark the sound engines.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "a5200_frameskip",
+      "Frameskip",
+      NULL,
+      "Skip frames to avoid audio buffer under-run (crackling). Improves performance at the expense of visual smoothness. 'Auto' skips frames when advised by the frontend. 'Manual' uses the 'Frameskip Threshold (%)' setting. 'Fixed' uses the 'Fixed Frameskip Interval' setting. Collision detection is unaffected.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "auto",     "Auto" },
+         { "manual",   "Manual" },
+         { "fixed",    "Fixed" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "a5200_frameskip_threshold",
+      "Frameskip Threshold (%)",
+      NULL,
+      "When 'Frameskip' is set to 'Manual', specifies the audio buffer occupancy threshold (percentage) below which frames will be skipped. Higher values reduce the risk of crackling by causing frames to be dropped more frequently.",
+      NULL,
+      NULL,
+      {
+         { "15", NULL },
+         { "18", NULL },
+         { "21", NULL },
+         { "24", NULL },
+         { "27", NULL },
+         { "30", NULL },
+         { "33", NULL },
+         { "36", NULL },
+         { "39", NULL },
+         { "42", NULL },
+         { "45", NULL },
+         { "48", NULL },
+         { "51", NULL },
+         { "54", NULL },
+         { "57", NULL },
+         { "60", NULL },
+         { NULL, NULL },
+      },
+      "33"
+   },
+   {
+      "a5200_frameskip_interval",
+      "Fixed Frameskip Interval",
+      NULL,
+      "When 'Frameskip' is set to 'Fixed', specifies the number of frames skipped after each displayed frame.",
+      NULL,
+      NULL,
+      {
+         { "1", NULL },
+         { "2", NULL },
+         { "3", NULL },
+         { "4", NULL },
+         { "5", NULL },
+         { "6", NULL },
+         { "7", NULL },
+         { "8", NULL },
+         { "9", NULL },
+         { NULL, NULL },
+      },
+      "1"
+   },
+   {
+      "a5200_governor",
+      "Quality Governor",
+      NULL,
+      "Time each frame and, when it takes longer than 'Quality Governor Threshold (%)' of the frame period for a sustained period, step down expensive features in turn: 'Interframe Blending', 'Hi-Res Artifacting Mode', 'High Fidelity POKEY' (switching to the standard engine) and finally the frame rate (skipping every other frame). Features are restored in reverse order once frames take less than 'Quality Governor Headroom (%)'. Each change is logged.",
+      NULL,
+      NULL,
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "a5200_governor_threshold",
+      "Quality Governor Threshold (%)",
+      NULL,
+      "When 'Quality Governor' is enabled, specifies the average frame time (as a percentage of the frame period) above which the next feature is stepped down.",
+      NULL,
+      NULL,
+      {
+         { "60",  NULL },
+         { "70",  NULL },
+         { "80",  NULL },
+         { "90",  NULL },
+         { "100", NULL },
+         { NULL, NULL },
+      },
+      "90"
+   },
+   {
+      "a5200_governor_headroom",
+      "Quality Governor Headroom (%)",
+      NULL,
+      "When 'Quality Governor' is enabled, specifies the average frame time (as a percentage of the frame period) below which the last feature stepped down is restored.",
+      NULL,
+      NULL,
+      {
+         { "20", NULL },
+         { "30", NULL },
+         { "40", NULL },
+         { "50", NULL },
+         { NULL, NULL },
+      },
+      "50"
+   },
    {
       "a5200_enable_new_pokey",
       "High Fidelity POKEY (Restart)",
       NULL,
-      "Enable High Fidelity Pokey for better quality sound.  Disable for games that use digital sound (Berzerk)",
+      "Enable High Fidelity Pokey for better quality sound.  Disable for games that use digital sound (Berzerk). 'Band-Limited' uses the standard engine, but band-limits every change of its output, which removes most of its aliasing at a fraction of the cost of High Fidelity POKEY.",
+      NULL,
+      "audio",
+      {
+         { "disabled",     NULL },
+         { "enabled",      NULL },
+         { "band_limited", "Band-Limited" },
+         { NULL, NULL },
+      },
+      "enabled"
+   },
+   {
+      "a5200_sample_rate",
+      "Audio Sample Rate",
+      NULL,
+      "Specify the sample rate of the audio output. The CPU cost of High Fidelity POKEY sound is roughly proportional to the sample rate: lower rates reduce the load on slow devices, while 48000 Hz avoids resampling by the frontend on systems whose audio hardware runs at this rate.",
+      NULL,
+      "audio",
+      {
+         { "22050", "22050 Hz" },
+         { "31440", "31440 Hz" },
+         { "44100", "44100 Hz" },
+         { "48000", "48000 Hz" },
+         { NULL, NULL },
+      },
+      "44100"
+   },
+#ifdef HAVE_PTHREAD
+   {
+      "a5200_audio_thread",
+      "Threaded Audio",
+      NULL,
+      "Generate High Fidelity POKEY sound on a separate thread, in parallel with emulation. Reduces frame times on multi-core devices, without affecting latency or the generated sound. Has no effect when High Fidelity POKEY is disabled.",
       NULL,
       "audio",
       {
@@ -129,8 +412,9 @@ struct retro_core_option_v2_definition option_defs_us[] = {
          { "enabled",  NULL },
          { NULL, NULL },
       },
-      "enabled"
+      "disabled"
    },
+#endif
    {
       "a5200_low_pass_filter",
       "Audio Filter",
@@ -0,0 +1,295 @@
+/* Player/missile compositing benchmark
+ *
+ * Draws randomised scanlines dense with players
+ * and missiles through the ANTIC draw routine of
+ * each playfield mode, and reports the median and
+ * minimum time per line of each. The median is the
+ * lowest of 'repeats' runs, to filter out
+ * interference from other processes. A hash of the
+ * pixels and collision registers produced is also
+ * printed, so that a change to the compositing
+ * code can be checked for identical output.
+ *
+ * The draw routines are static, so antic.c is
+ * included directly. To compare two revisions,
+ * build against each with CORE_SRC_DIR set to its
+ * emu directory (see Makefile).
+ *
+ * Usage: pmg_bench [-l lines] [-n repeats] [-s] [-p]
+ *   -s  sprites keep their position and data over
+ *       all lines, drawn over a text-like screen
+ *   -p  no player/missile data (playfield only) */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <boolean.h>
+
+#include "antic.c"
+
+#define BENCH_MAX_LINES     100000
+/* Lines are drawn once for each of the
+ * character rows of a mode line */
+#define BENCH_ROWS_PER_LINE 8
+/* Colour clock of the first drawn playfield byte */
+#define BENCH_X             32
+
+/* Emulator state used by antic.c and gtia.c.
+ * Only their draw routines run here, so the
+ * CPU, POKEY and state saving are stubs */
+UBYTE memory[65536 + 2];
+UBYTE attrib[65536];
+UWORD regPC        = 0;
+int tv_mode        = 262;
+int hold_start     = 0;
+int press_space    = 0;
+int key_consol     = CONSOL_NONE;
+uint8_t *a5200_screen_buffer = NULL;
+
+void GO(int limit) { (void)limit; }
+void NMI(void) { }
+void POKEY_Scanline(void) { }
+UBYTE Atari800_GetByte(UWORD addr) { return memory[addr]; }
+void CopyFromMem(UWORD from, UBYTE *to, int size) { memcpy(to, memory + from, size); }
+void SaveUBYTE(const UBYTE *data, int num) { (void)data; (void)num; }
+void SaveUWORD(const UWORD *data, int num) { (void)data; (void)num; }
+void SaveINT(const int *data, int num) { (void)data; (void)num; }
+void ReadUBYTE(UBYTE *data, int num) { (void)data; (void)num; }
+void ReadUWORD(UWORD *data, int num) { (void)data; (void)num; }
+void ReadINT(int *data, int num) { (void)data; (void)num; }
+
+typedef void (*bench_draw_t)(int nchars, const UBYTE *ANTIC_memptr,
+      UWORD *ptr, const ULONG *t_pm_scanline_ptr);
+
+typedef struct
+{
+   const char *name;
+   bench_draw_t draw;
+   int nchars;
+} bench_mode_t;
+
+static const bench_mode_t modes[] =
+{
+   { "2", draw_antic_2, 40 },
+   { "4", draw_antic_4, 40 },
+   { "6", draw_antic_6, 20 },
+   { "8", draw_antic_8, 10 },
+   { "9", draw_antic_9, 10 },
+   { "a", draw_antic_a, 20 },
+   { "c", draw_antic_c, 20 },
+   { "e", draw_antic_e, 40 },
+   { "f", draw_antic_f, 40 },
+};
+
+static UWORD out[BENCH_ROWS_PER_LINE][ATARI_WIDTH];
+static double line_times[BENCH_MAX_LINES];
+
+/* xorshift32, so that every run draws the same lines */
+static uint32_t rand_state;
+
+static uint32_t rand_next(void)
+{
+   rand_state ^= rand_state << 13;
+   rand_state ^= rand_state >> 17;
+   rand_state ^= rand_state << 5;
+   return rand_state;
+}
+
+static uint64_t hash;
+
+static void hash_data(const void *data, size_t size)
+{
+   const UBYTE *bytes = (const UBYTE*)data;
+   size_t i;
+
+   for (i = 0; i < size; i++)
+   {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+   }
+}
+
+static double get_time(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Places all players and missiles over the
+ * playfield, mostly as solid (0xff) or random
+ * graphics with random sizes, colours and
+ * priorities */
+static void setup_pmg(void)
+{
+   int i;
+
+   for (i = 0; i < 4; i++)
+   {
+      UBYTE graf = (rand_next() & 1) ? 0xff : (UBYTE)rand_next();
+
+      GTIA_PutByte(_HPOSP0 + i, 48 + rand_next() % 160);
+      GTIA_PutByte(_HPOSM0 + i, 48 + rand_next() % 160);
+      GTIA_PutByte(_SIZEP0 + i, rand_next() & 3);
+      GTIA_PutByte(_GRAFP0 + i, (rand_next() & 7) ? graf : 0);
+   }
+
+   GTIA_PutByte(_SIZEM, (UBYTE)rand_next());
+   GTIA_PutByte(_GRAFM, (UBYTE)rand_next());
+   GTIA_PutByte(_PRIOR, (rand_next() & 3) ? 1 : rand_next() & 0x3f);
+
+   for (i = _COLPM0; i <= _COLBK; i++)
+      GTIA_PutByte(i, rand_next() & 0xfe);
+}
+
+/* Fills 'screen' with playfield data: a mix of
+ * blank, solid, single colour and random bytes,
+ * or with character codes if 'text' is set */
+static void setup_screen(UBYTE *screen, size_t size, bool text)
+{
+   size_t i;
+
+   for (i = 0; i < size; i++)
+   {
+      if (text)
+         screen[i] = 0x20 + rand_next() % 24;
+      else
+      {
+         switch (rand_next() & 3)
+         {
+            case 0:
+               screen[i] = 0;
+               break;
+            case 1:
+               screen[i] = 0xff;
+               break;
+            case 2:
+               screen[i] = 0x55 * (rand_next() & 3);
+               break;
+            default:
+               screen[i] = (UBYTE)rand_next();
+               break;
+         }
+      }
+   }
+}
+
+static int compare_times(const void *a, const void *b)
+{
+   double x = *(const double*)a;
+   double y = *(const double*)b;
+
+   return (x < y) ? -1 : (x > y);
+}
+
+static void usage(void)
+{
+   fprintf(stderr, "Usage: pmg_bench [-l lines] [-n repeats] [-s] [-p]\n");
+}
+
+int main(int argc, char **argv)
+{
+   int num_lines     = 20000;
+   int repeats       = 5;
+   bool static_pmg   = false;
+   bool no_pmg       = false;
+   UBYTE screen[48];
+   size_t m;
+   int arg;
+
+   for (arg = 1; arg < argc; arg++)
+   {
+      if (!strcmp(argv[arg], "-l") && arg + 1 < argc)
+         num_lines = atoi(argv[++arg]);
+      else if (!strcmp(argv[arg], "-n") && arg + 1 < argc)
+         repeats = atoi(argv[++arg]);
+      else if (!strcmp(argv[arg], "-s"))
+         static_pmg = true;
+      else if (!strcmp(argv[arg], "-p"))
+         no_pmg = true;
+      else
+      {
+         usage();
+         return 1;
+      }
+   }
+
+   if (num_lines < 1 || num_lines > BENCH_MAX_LINES || repeats < 1)
+   {
+      usage();
+      return 1;
+   }
+
+   /* Random memory, so fonts are random too */
+   rand_state = 12345;
+   for (arg = 0; arg < 65536; arg++)
+      memory[arg] = (UBYTE)rand_next();
+
+   ANTIC_Initialise();
+   GTIA_Initialise();
+
+   left_border_chars  = 0;
+   right_border_start = RBORDER_END;
+   chbase_20          = 0xe000;
+   anticmode          = 4;
+
+   for (m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+   {
+      double median = 0.0;
+      double min    = 0.0;
+      int r;
+
+      for (r = 0; r < repeats; r++)
+      {
+         int line;
+
+         /* Every run draws the same lines */
+         rand_state = 777 + (uint32_t)m;
+         hash       = 1469598103934665603ULL;
+
+         for (line = 0; line < num_lines; line++)
+         {
+            double start;
+            int row;
+
+            if (!static_pmg || line == 0)
+               setup_pmg();
+            setup_screen(screen, sizeof(screen), static_pmg);
+
+            new_pm_scanline();
+            if (no_pmg)
+               memset(pm_scanline, 0, sizeof(pm_scanline));
+
+            start = get_time();
+            for (row = 0; row < BENCH_ROWS_PER_LINE; row++)
+            {
+               dctr     = row;
+               scrn_ptr = out[row];
+               modes[m].draw(modes[m].nchars, screen, out[row] + BENCH_X,
+                     (const ULONG *) &pm_scanline[BENCH_X]);
+            }
+            line_times[line] = (get_time() - start) / BENCH_ROWS_PER_LINE;
+
+            hash_data(out, sizeof(out));
+            hash_data(&M0PL, 1); hash_data(&M1PL, 1);
+            hash_data(&M2PL, 1); hash_data(&M3PL, 1);
+            hash_data(&P0PL, 1); hash_data(&P1PL, 1);
+            hash_data(&P2PL, 1); hash_data(&P3PL, 1);
+         }
+
+         qsort(line_times, num_lines, sizeof(double), compare_times);
+         if (r == 0 || line_times[num_lines / 2] < median)
+            median = line_times[num_lines / 2];
+         if (r == 0 || line_times[0] < min)
+            min = line_times[0];
+      }
+
+      printf("mode %-2s median %7.1f min %7.1f ns/line  hash %016llx\n",
+            modes[m].name, median, min, (unsigned long long)hash);
+   }
+
+   return 0;
+}
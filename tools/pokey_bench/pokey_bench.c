@@ -0,0 +1,603 @@
+/* POKEY synthesis benchmark
+ *
+ * Replays a POKEY register trace recorded by the
+ * core (see libretro/a5200_pokey_trace.h) through
+ * each sound engine at several quality settings,
+ * and reports the synthesis speed of each, and the
+ * difference of its output from that of the
+ * highest quality setting.
+ *
+ * Usage: pokey_bench [-r rate] [-n repeats] trace */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "atari.h"
+#include "pokey.h"
+#include "pokeysnd.h"
+
+#include "a5200_pokey_trace.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define BENCH_FFT_SIZE 2048
+/* Largest lag (in samples) searched when aligning
+ * an output with the reference, as the engines
+ * (and the resampling filters of each quality
+ * setting) have different delays */
+#define BENCH_MAX_LAG  64
+
+/* Emulator state used by the sound engines */
+unsigned int screenline_cpu_clock = 0;
+int xpos                          = 0;
+int tv_mode                       = 262;
+int atari_speaker                 = 0;
+
+UBYTE AUDF[4 * MAXPOKEYS];
+UBYTE AUDC[4 * MAXPOKEYS];
+UBYTE AUDCTL[MAXPOKEYS];
+int Base_mult[MAXPOKEYS];
+UBYTE poly9_lookup[POLY9_SIZE];
+UBYTE poly17_lookup[16385];
+
+void *Util_malloc(size_t size)
+{
+   void *ptr = malloc(size);
+
+   if (!ptr)
+   {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+   }
+
+   return ptr;
+}
+
+/************************************
+ * Trace
+ ************************************/
+
+typedef struct
+{
+   uint32_t tick;
+   uint8_t tag;
+   uint8_t value;
+   uint8_t gain;
+} bench_event_t;
+
+static bench_event_t *events  = NULL;
+static size_t num_events      = 0;
+static size_t num_frames      = 0;
+static double trace_frame_rate;
+
+static bool read_trace(const char *path)
+{
+   FILE *file         = fopen(path, "rb");
+   uint8_t header[A5200_POKEY_TRACE_HEADER_SIZE];
+   size_t events_size = 0;
+   uint32_t tick      = 0;
+   uint8_t gain       = 4;
+   bool first         = true;
+   int tag;
+
+   if (!file)
+   {
+      fprintf(stderr, "Unable to open %s\n", path);
+      return false;
+   }
+
+   if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+       memcmp(header, A5200_POKEY_TRACE_MAGIC, 7) ||
+       header[7] != A5200_POKEY_TRACE_VERSION)
+   {
+      fprintf(stderr, "%s is not a POKEY trace\n", path);
+      fclose(file);
+      return false;
+   }
+
+   trace_frame_rate = (header[8] | (header[9] << 8) |
+         (header[10] << 16) | ((uint32_t)header[11] << 24)) / 1000.0;
+   tv_mode          = header[12] | (header[13] << 8);
+
+   while ((tag = fgetc(file)) != EOF)
+   {
+      uint32_t delta = 0;
+      int shift      = 0;
+      int byte;
+
+      do
+      {
+         if ((byte = fgetc(file)) == EOF)
+            break;
+         delta |= (uint32_t)(byte & 0x7F) << shift;
+         shift += 7;
+      } while (byte & 0x80);
+
+      /* The first delta is the cycle at which
+       * recording started */
+      if (!first)
+         tick += delta;
+      first = false;
+
+      if (tag == A5200_POKEY_TRACE_GAIN)
+      {
+         if ((byte = fgetc(file)) == EOF)
+            break;
+         gain = byte;
+         continue;
+      }
+
+      if (num_events == events_size)
+      {
+         events_size = events_size ? events_size * 2 : 65536;
+         events      = (bench_event_t*)realloc(events,
+               events_size * sizeof(bench_event_t));
+         if (!events)
+         {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+         }
+      }
+
+      events[num_events].tick  = tick;
+      events[num_events].tag   = tag;
+      events[num_events].value = 0;
+      events[num_events].gain  = gain;
+
+      if (tag != A5200_POKEY_TRACE_FRAME)
+      {
+         if ((byte = fgetc(file)) == EOF)
+            break;
+         events[num_events].value = byte;
+      }
+      else
+         num_frames++;
+
+      num_events++;
+   }
+
+   fclose(file);
+   return num_frames > 0;
+}
+
+/************************************
+ * Replay
+ ************************************/
+
+typedef struct
+{
+   const char *name;
+   int new_pokey;
+   int band_limited;
+   int quality;
+   unsigned flags;
+} bench_config_t;
+
+static const bench_config_t configs[] =
+{
+   { "rf 8-bit",              0, 0, 0, 0 },
+   { "rf 16-bit",             0, 0, 0, POKEYSND_BIT16 },
+   { "rf 16-bit stereo",      0, 0, 0, POKEYSND_BIT16 | POKEYSND_STEREO },
+   { "rf blep 8-bit",         0, 1, 0, 0 },
+   { "rf blep 16-bit stereo", 0, 1, 0, POKEYSND_BIT16 | POKEYSND_STEREO },
+   { "mz q0 8-bit",           1, 0, 0, 0 },
+   { "mz q0 16-bit stereo",   1, 0, 0, POKEYSND_BIT16 | POKEYSND_STEREO },
+   { "mz q1 16-bit stereo",   1, 0, 1, POKEYSND_BIT16 | POKEYSND_STEREO },
+   { "mz q2 16-bit stereo",   1, 0, 2, POKEYSND_BIT16 | POKEYSND_STEREO },
+};
+
+#define NUM_CONFIGS (sizeof(configs) / sizeof(configs[0]))
+/* Highest quality setting, against which the
+ * others are compared */
+#define REFERENCE_CONFIG (NUM_CONFIGS - 1)
+
+static void init_poly(void)
+{
+   int i;
+   uint32_t reg;
+
+   /* As POKEY_Initialise() */
+   reg = 0x1ff;
+   for (i = 0; i < POLY9_SIZE; i++)
+   {
+      reg = ((((reg >> 5) ^ reg) & 1) << 8) + (reg >> 1);
+      poly9_lookup[i] = (UBYTE)reg;
+   }
+   reg = 0x1ffff;
+   for (i = 0; i < 16385; i++)
+   {
+      reg = ((((reg >> 5) ^ reg) & 0xff) << 9) + (reg >> 8);
+      poly17_lookup[i] = (UBYTE)(reg >> 1);
+   }
+}
+
+/* Updates the registers read by the rf engine,
+ * as POKEY_PutByte() */
+static void write_register(uint8_t reg, uint8_t value)
+{
+   switch (reg)
+   {
+      case OFFSET_AUDF1:
+      case OFFSET_AUDF2:
+      case OFFSET_AUDF3:
+      case OFFSET_AUDF4:
+         AUDF[reg >> 1] = value;
+         break;
+      case OFFSET_AUDC1:
+      case OFFSET_AUDC2:
+      case OFFSET_AUDC3:
+      case OFFSET_AUDC4:
+         AUDC[reg >> 1] = value;
+         break;
+      case OFFSET_AUDCTL:
+         AUDCTL[0]    = value;
+         Base_mult[0] = (value & CLOCK_15) ? DIV_15 : DIV_64;
+         break;
+      default:
+         break;
+   }
+}
+
+static double get_time(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Replays the trace, storing the left channel of
+ * the output in 'out' (if not NULL). Returns the
+ * time taken in seconds */
+static double replay(const bench_config_t *config, int rate,
+      float *out, size_t *num_samples)
+{
+   size_t sample_size = POKEYSND_SAMPLE_SIZE(config->flags);
+   size_t count       = 0;
+   double start;
+   size_t i;
+
+   memset(AUDF, 0, sizeof(AUDF));
+   memset(AUDC, 0, sizeof(AUDC));
+   memset(AUDCTL, 0, sizeof(AUDCTL));
+   for (i = 0; i < MAXPOKEYS; i++)
+      Base_mult[i] = DIV_64;
+
+   screenline_cpu_clock      = 0;
+   POKEYSND_enable_new_pokey = config->new_pokey;
+   POKEYSND_band_limited     = config->band_limited;
+   POKEYSND_frame_rate       = trace_frame_rate;
+   POKEYSND_lowpass_factor   = 0;
+   POKEYSND_SetMzQuality(config->quality);
+   Pokey_sound_init(FREQ_17_EXACT, (UWORD)rate, 1, config->flags);
+
+   start = get_time();
+
+   for (i = 0; i < num_events; i++)
+   {
+      const bench_event_t *event = &events[i];
+
+      screenline_cpu_clock = event->tick;
+
+      if (event->tag == A5200_POKEY_TRACE_FRAME)
+      {
+         int samples = POKEYSND_UpdateProcessBuffer();
+         int j;
+
+         if (!out)
+            continue;
+
+         for (j = 0; j < samples; j++)
+         {
+            const UBYTE *sample = POKEYSND_process_buffer + j * sample_size;
+
+            if (config->flags & POKEYSND_BIT16)
+               out[count + j] = *(const SWORD*)sample;
+            else
+               out[count + j] = (sample[0] - POKEYSND_SAMP_MID) * 256.0f;
+         }
+         count += samples;
+      }
+      /* The core emulates a single POKEY */
+      else if (!(event->tag >> 4))
+      {
+         write_register(event->tag & 0x0F, event->value);
+         POKEYSND_Update(event->tag & 0x0F, event->value, 0, event->gain);
+      }
+   }
+
+   if (num_samples)
+      *num_samples = count;
+
+   return get_time() - start;
+}
+
+/************************************
+ * Comparison
+ ************************************/
+
+static void remove_mean(float *data, size_t size)
+{
+   double sum = 0.0;
+   size_t i;
+
+   for (i = 0; i < size; i++)
+      sum += data[i];
+   for (i = 0; i < size; i++)
+      data[i] -= (float)(sum / size);
+}
+
+/* Signal to noise ratio in dB of 'data' against
+ * 'ref', at the lag which maximises it. As the
+ * engines differ in output level, 'data' is first
+ * scaled by the gain which minimises the noise */
+static double get_snr(const float *data, const float *ref, size_t size,
+      int *best_lag)
+{
+   double best_snr = -1000.0;
+   int lag;
+
+   *best_lag = 0;
+
+   if (size <= 2 * BENCH_MAX_LAG)
+      return best_snr;
+
+   for (lag = -BENCH_MAX_LAG; lag <= BENCH_MAX_LAG; lag++)
+   {
+      double signal = 0.0;
+      double power  = 0.0;
+      double cross  = 0.0;
+      double noise;
+      double snr;
+      size_t i;
+
+      for (i = BENCH_MAX_LAG; i < size - BENCH_MAX_LAG; i++)
+      {
+         signal += (double)ref[i] * ref[i];
+         power  += (double)data[i + lag] * data[i + lag];
+         cross  += (double)data[i + lag] * ref[i];
+      }
+
+      noise = (power > 0.0) ? signal - cross * cross / power : signal;
+
+      if (noise <= signal * 1e-12)
+         snr = 999.0;
+      else if (signal == 0.0)
+         snr = -999.0;
+      else
+         snr = 10.0 * log10(signal / noise);
+
+      if (snr > best_snr)
+      {
+         best_snr  = snr;
+         *best_lag = lag;
+      }
+   }
+
+   return best_snr;
+}
+
+/* In-place radix-2 FFT */
+static void fft(double *re, double *im, size_t size)
+{
+   size_t i, j, len;
+
+   for (i = 1, j = 0; i < size; i++)
+   {
+      size_t bit = size >> 1;
+
+      for (; j & bit; bit >>= 1)
+         j ^= bit;
+      j ^= bit;
+
+      if (i < j)
+      {
+         double tmp = re[i];
+         re[i]      = re[j];
+         re[j]      = tmp;
+         tmp        = im[i];
+         im[i]      = im[j];
+         im[j]      = tmp;
+      }
+   }
+
+   for (len = 2; len <= size; len <<= 1)
+   {
+      double angle = -2.0 * M_PI / len;
+
+      for (i = 0; i < size; i += len)
+      {
+         for (j = 0; j < len / 2; j++)
+         {
+            double w_re = cos(angle * j);
+            double w_im = sin(angle * j);
+            size_t a    = i + j;
+            size_t b    = a + len / 2;
+            double t_re = re[b] * w_re - im[b] * w_im;
+            double t_im = re[b] * w_im + im[b] * w_re;
+
+            re[b]  = re[a] - t_re;
+            im[b]  = im[a] - t_im;
+            re[a] += t_re;
+            im[a] += t_im;
+         }
+      }
+   }
+}
+
+/* Averages the power spectra of Hann windowed
+ * blocks of 'data' */
+static void get_spectrum(const float *data, size_t size, double *power)
+{
+   double re[BENCH_FFT_SIZE];
+   double im[BENCH_FFT_SIZE];
+   size_t pos, i;
+
+   memset(power, 0, (BENCH_FFT_SIZE / 2) * sizeof(double));
+
+   for (pos = 0; pos + BENCH_FFT_SIZE <= size; pos += BENCH_FFT_SIZE)
+   {
+      for (i = 0; i < BENCH_FFT_SIZE; i++)
+      {
+         double window = 0.5 - 0.5 * cos(2.0 * M_PI * i / BENCH_FFT_SIZE);
+
+         re[i] = data[pos + i] * window;
+         im[i] = 0.0;
+      }
+
+      fft(re, im, BENCH_FFT_SIZE);
+
+      for (i = 0; i < BENCH_FFT_SIZE / 2; i++)
+         power[i] += re[i] * re[i] + im[i] * im[i];
+   }
+}
+
+/* Mean absolute difference in dB between the
+ * spectra of 'data' and 'ref', after matching
+ * their total power. Bins more than 100 dB below
+ * the peak of the reference are compared at that
+ * level */
+static double get_spectral_diff(const double *power, const double *ref)
+{
+   double peak      = 0.0;
+   double sum       = 0.0;
+   double total     = 0.0;
+   double ref_total = 0.0;
+   double scale;
+   double floor_level;
+   size_t i;
+
+   for (i = 0; i < BENCH_FFT_SIZE / 2; i++)
+   {
+      total     += power[i];
+      ref_total += ref[i];
+      if (ref[i] > peak)
+         peak = ref[i];
+   }
+
+   if (peak == 0.0 || total == 0.0)
+      return 0.0;
+
+   scale       = ref_total / total;
+   floor_level = peak * 1e-10;
+
+   for (i = 0; i < BENCH_FFT_SIZE / 2; i++)
+   {
+      double a = power[i] * scale;
+      double b = ref[i];
+
+      if (a < floor_level)
+         a = floor_level;
+      if (b < floor_level)
+         b = floor_level;
+
+      sum += fabs(10.0 * log10(a / b));
+   }
+
+   return sum / (BENCH_FFT_SIZE / 2);
+}
+
+/************************************
+ * Main
+ ************************************/
+
+static void usage(void)
+{
+   fprintf(stderr, "Usage: pokey_bench [-r rate] [-n repeats] trace\n");
+   exit(1);
+}
+
+int main(int argc, char **argv)
+{
+   static double ref_power[BENCH_FFT_SIZE / 2];
+   static double power[BENCH_FFT_SIZE / 2];
+   const char *path  = NULL;
+   int rate          = 44100;
+   int repeats       = 5;
+   float *outputs[NUM_CONFIGS];
+   size_t sizes[NUM_CONFIGS];
+   double times[NUM_CONFIGS];
+   size_t max_samples;
+   size_t i;
+   int arg;
+
+   for (arg = 1; arg < argc; arg++)
+   {
+      if (!strcmp(argv[arg], "-r") && arg + 1 < argc)
+         rate = atoi(argv[++arg]);
+      else if (!strcmp(argv[arg], "-n") && arg + 1 < argc)
+         repeats = atoi(argv[++arg]);
+      else if (argv[arg][0] == '-' || path)
+         usage();
+      else
+         path = argv[arg];
+   }
+
+   if (!path || rate < 8000 || rate > 65535 || repeats < 1)
+      usage();
+
+   if (!read_trace(path))
+      return 1;
+
+   init_poly();
+
+   /* Every frame produces rate / frame rate
+    * samples, with some leeway for rounding */
+   max_samples = (size_t)((double)rate / trace_frame_rate + 2.0) * num_frames;
+
+   printf("%s: %lu frames (%.2f s at %.3f Hz), %lu events, %d Hz\n\n",
+         path, (unsigned long)num_frames, num_frames / trace_frame_rate,
+         trace_frame_rate, (unsigned long)num_events, rate);
+
+   for (i = 0; i < NUM_CONFIGS; i++)
+   {
+      int repeat;
+
+      outputs[i] = (float*)Util_malloc(max_samples * sizeof(float));
+      times[i]   = replay(&configs[i], rate, outputs[i], &sizes[i]);
+
+      for (repeat = 1; repeat < repeats; repeat++)
+      {
+         double time = replay(&configs[i], rate, NULL, NULL);
+
+         if (time < times[i])
+            times[i] = time;
+      }
+
+      remove_mean(outputs[i], sizes[i]);
+   }
+
+   get_spectrum(outputs[REFERENCE_CONFIG], sizes[REFERENCE_CONFIG],
+         ref_power);
+
+   printf("%-22s %12s %10s %10s %9s %5s %10s\n",
+         "engine", "samples/s", "ns/sample", "realtime", "SNR (dB)",
+         "lag", "spec (dB)");
+
+   for (i = 0; i < NUM_CONFIGS; i++)
+   {
+      size_t size = sizes[i] < sizes[REFERENCE_CONFIG] ?
+            sizes[i] : sizes[REFERENCE_CONFIG];
+      double samples_per_sec = sizes[i] / times[i];
+      int lag;
+      double snr = get_snr(outputs[i], outputs[REFERENCE_CONFIG], size, &lag);
+
+      get_spectrum(outputs[i], size, power);
+
+      printf("%-22s %12.0f %10.1f %9.1fx %9.1f %5d %10.2f\n",
+            configs[i].name, samples_per_sec, 1e9 / samples_per_sec,
+            (num_frames / trace_frame_rate) / times[i],
+            snr, lag, get_spectral_diff(power, ref_power));
+   }
+
+   for (i = 0; i < NUM_CONFIGS; i++)
+      free(outputs[i]);
+   free(events);
+
+   return 0;
+}